@@ -0,0 +1,67 @@
+#ifndef TINYLA_BATCH_HPP
+#define TINYLA_BATCH_HPP
+
+#include <tinyla/mat.hpp>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+namespace tinyla
+{
+    enum class store_hint {
+        automatic,  // streaming for outputs that do not fit in cache, cached otherwise
+        cached,
+        streaming   // non-temporal stores bypassing the cache where supported
+    };
+
+    /**
+    * out[i] = lhs * rhs[i]
+    * lhs is kept in registers while rhs is streamed through.
+    * out may be the same range as rhs.
+    */
+    template<typename T>
+    void multiply(mat<4,T> const& lhs, std::span<const mat<4,std::type_identity_t<T>>> rhs,
+                  std::span<mat<4,std::type_identity_t<T>>> out, store_hint hint = store_hint::automatic);
+
+    /**
+    * out[i] = lhs[i] * rhs
+    * rhs is kept in registers while lhs is streamed through.
+    * out may be the same range as lhs.
+    */
+    template<typename T>
+    void multiply(std::span<const mat<4,std::type_identity_t<T>>> lhs, mat<4,T> const& rhs,
+                  std::span<mat<4,std::type_identity_t<T>>> out, store_hint hint = store_hint::automatic);
+
+    /**
+    * out[i] = m * (points[i], 1), dropping w; m is assumed to be affine.
+    * out may be the same range as points.
+    */
+    template<typename T>
+    void transform_points(mat<4,T> const& m, std::span<const vec<3,std::type_identity_t<T>>> points,
+                          std::span<vec<3,std::type_identity_t<T>>> out);
+
+    /**
+    * out[i] = m * (points[i], 1) divided by its w, dropping w. Points with w == 0 are not divided.
+    * out may be the same range as points.
+    */
+    template<typename T>
+    void project_points(mat<4,T> const& m, std::span<const vec<3,std::type_identity_t<T>>> points,
+                        std::span<vec<3,std::type_identity_t<T>>> out);
+
+    namespace detail {
+        // Outputs larger than this are assumed not to be reused from cache.
+        constexpr std::size_t streaming_threshold_bytes = std::size_t{8} << 20;
+
+        template<typename T>
+        bool use_streaming_stores(std::span<mat<4,T>> out, store_hint hint);
+
+        template<typename T>
+        void store(T* dst, T const (&src)[16], bool streaming);
+
+        void store_fence();
+    }
+}
+
+#include "batch.inl"
+
+#endif // TINYLA_BATCH_HPP
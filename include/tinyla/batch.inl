@@ -0,0 +1,159 @@
+#ifndef TINYLA_BATCH_INL
+#define TINYLA_BATCH_INL
+
+#include <cstdint>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define TINYLA_HAS_STREAMING_STORES
+#endif
+
+namespace tinyla
+{
+    template<typename T>
+    void multiply(mat<4,T> const& lhs, std::span<const mat<4,std::type_identity_t<T>>> rhs,
+                  std::span<mat<4,std::type_identity_t<T>>> out, store_hint hint)
+    {
+        assert(rhs.size() == out.size());
+        TINYLA_COUNT(mat_mul_mat_batched, T, rhs.size());
+        bool const streaming = detail::use_streaming_stores(out, hint);
+
+        // Column-major: a[k][r] is the element in row r of column k.
+        T a[4][4];
+        std::copy_n(lhs.data(), 16, &a[0][0]);
+
+        for (std::size_t i = 0; i < rhs.size(); ++i) {
+            T const* b = rhs[i].data();
+            T c[16];
+            for (std::size_t j = 0; j < 4; ++j) {
+                for (std::size_t r = 0; r < 4; ++r) {
+                    c[j * 4 + r] = a[0][r] * b[j * 4 + 0]
+                                 + a[1][r] * b[j * 4 + 1]
+                                 + a[2][r] * b[j * 4 + 2]
+                                 + a[3][r] * b[j * 4 + 3];
+                }
+            }
+            detail::store(out[i].data(), c, streaming);
+        }
+
+        if (streaming) detail::store_fence();
+    }
+
+    template<typename T>
+    void multiply(std::span<const mat<4,std::type_identity_t<T>>> lhs, mat<4,T> const& rhs,
+                  std::span<mat<4,std::type_identity_t<T>>> out, store_hint hint)
+    {
+        assert(lhs.size() == out.size());
+        TINYLA_COUNT(mat_mul_mat_batched, T, lhs.size());
+        bool const streaming = detail::use_streaming_stores(out, hint);
+
+        // Column-major: b[j][k] is the element in row k of column j.
+        T b[4][4];
+        std::copy_n(rhs.data(), 16, &b[0][0]);
+
+        for (std::size_t i = 0; i < lhs.size(); ++i) {
+            T const* a = lhs[i].data();
+            T c[16];
+            for (std::size_t j = 0; j < 4; ++j) {
+                for (std::size_t r = 0; r < 4; ++r) {
+                    c[j * 4 + r] = a[0 * 4 + r] * b[j][0]
+                                 + a[1 * 4 + r] * b[j][1]
+                                 + a[2 * 4 + r] * b[j][2]
+                                 + a[3 * 4 + r] * b[j][3];
+                }
+            }
+            detail::store(out[i].data(), c, streaming);
+        }
+
+        if (streaming) detail::store_fence();
+    }
+
+    template<typename T>
+    void transform_points(mat<4,T> const& m, std::span<const vec<3,std::type_identity_t<T>>> points,
+                          std::span<vec<3,std::type_identity_t<T>>> out)
+    {
+        assert(points.size() == out.size());
+
+        T a[4][4];
+        std::copy_n(m.data(), 16, &a[0][0]);
+
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            auto const p = points[i];
+            for (std::size_t r = 0; r < 3; ++r) {
+                out[i][r] = a[0][r] * p[0] + a[1][r] * p[1] + a[2][r] * p[2] + a[3][r];
+            }
+        }
+    }
+
+    template<typename T>
+    void project_points(mat<4,T> const& m, std::span<const vec<3,std::type_identity_t<T>>> points,
+                        std::span<vec<3,std::type_identity_t<T>>> out)
+    {
+        assert(points.size() == out.size());
+
+        T a[4][4];
+        std::copy_n(m.data(), 16, &a[0][0]);
+
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            auto const p = points[i];
+            T c[4];
+            for (std::size_t r = 0; r < 4; ++r) {
+                c[r] = a[0][r] * p[0] + a[1][r] * p[1] + a[2][r] * p[2] + a[3][r];
+            }
+            T const w = c[3] != T{0} ? c[3] : T{1};
+            for (std::size_t r = 0; r < 3; ++r) out[i][r] = c[r] / w;
+        }
+    }
+
+    namespace detail {
+        template<typename T>
+        bool use_streaming_stores(std::span<mat<4,T>> out, store_hint hint)
+        {
+#ifdef TINYLA_HAS_STREAMING_STORES
+            if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
+                // Non-temporal stores need 16-byte aligned destinations.
+                if (reinterpret_cast<std::uintptr_t>(out.data()) % 16 != 0) return false;
+                switch (hint) {
+                    case store_hint::automatic:
+                        return out.size_bytes() > streaming_threshold_bytes;
+                    case store_hint::cached:
+                        return false;
+                    case store_hint::streaming:
+                        return true;
+                }
+            }
+#endif
+            (void) out;
+            (void) hint;
+            return false;
+        }
+
+        template<typename T>
+        void store(T* dst, T const (&src)[16], bool streaming)
+        {
+#ifdef TINYLA_HAS_STREAMING_STORES
+            if constexpr (std::is_same_v<T, float>) {
+                if (streaming) {
+                    for (std::size_t i = 0; i < 16; i += 4) _mm_stream_ps(dst + i, _mm_loadu_ps(src + i));
+                    return;
+                }
+            } else if constexpr (std::is_same_v<T, double>) {
+                if (streaming) {
+                    for (std::size_t i = 0; i < 16; i += 2) _mm_stream_pd(dst + i, _mm_loadu_pd(src + i));
+                    return;
+                }
+            }
+#endif
+            (void) streaming;
+            std::copy_n(src, 16, dst);
+        }
+
+        inline void store_fence()
+        {
+#ifdef TINYLA_HAS_STREAMING_STORES
+            _mm_sfence();
+#endif
+        }
+    }
+}
+
+#endif // TINYLA_BATCH_INL
@@ -0,0 +1,201 @@
+#ifndef TINYLA_COUNTERS_HPP
+#define TINYLA_COUNTERS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string_view>
+#include <type_traits>
+
+/**
+* Opt-in call counters for hot tinyla operations.
+*
+* Define TINYLA_ENABLE_COUNTERS (the CMake option of the same name does so) to count calls
+* per operation and scalar type in per-thread counters. Without it TINYLA_COUNT expands to nothing.
+*/
+
+namespace tinyla::counters
+{
+    enum class op : std::size_t {
+        mat_mul_mat,
+        mat_mul_vec,
+        mat_mul_mat_batched,    // counts matrices, not calls
+        determinant,
+        inverted,
+        normalize,
+        normalized,
+        pre_rotate_x,
+        pre_rotate_y,
+        pre_rotate_z,
+        pre_rotate_axis,        // fallback to rotation(angle, axis) * m
+        post_rotate_x,
+        post_rotate_y,
+        post_rotate_z,
+        post_rotate_axis,       // fallback to m * rotation(angle, axis)
+        count
+    };
+
+    enum class scalar : std::size_t {
+        int_,
+        float_,
+        double_,
+        long_double_,
+        other,
+        count
+    };
+
+    class snapshot {
+    public:
+        constexpr std::uint64_t operator[](op op, scalar scalar) const
+        {
+            return m_counts[static_cast<std::size_t>(op)][static_cast<std::size_t>(scalar)];
+        }
+        constexpr std::uint64_t& operator[](op op, scalar scalar)
+        {
+            return m_counts[static_cast<std::size_t>(op)][static_cast<std::size_t>(scalar)];
+        }
+
+        // Total over all scalar types.
+        constexpr std::uint64_t total(op op) const;
+
+        constexpr friend snapshot operator-(snapshot const& later, snapshot const& earlier);
+    private:
+        std::array<std::array<std::uint64_t, static_cast<std::size_t>(scalar::count)>,
+                   static_cast<std::size_t>(op::count)> m_counts{};
+    };
+
+    constexpr std::string_view name(op op);
+    constexpr std::string_view name(scalar scalar);
+
+    template<typename T>
+    constexpr scalar scalar_of();
+
+    // Counters of the calling thread.
+    snapshot take_snapshot();
+    void reset();
+
+    // Writes the non-zero counters as "operation scalar count" lines; a template so that this header,
+    // which vec.hpp includes, only needs <iosfwd>.
+    template<typename CharT, typename Traits>
+    void dump(std::basic_ostream<CharT, Traits>& os, snapshot const& snapshot);
+
+    template<typename T>
+    void increment(op op, std::uint64_t n = 1);
+
+    namespace detail {
+        snapshot& thread_counters();
+    }
+}
+
+#ifdef TINYLA_ENABLE_COUNTERS
+#define TINYLA_COUNT(operation, T, ...) \
+    do { \
+        if (!std::is_constant_evaluated()) { \
+            ::tinyla::counters::increment<T>(::tinyla::counters::op::operation __VA_OPT__(,) __VA_ARGS__); \
+        } \
+    } while (false)
+#else
+#define TINYLA_COUNT(operation, T, ...) do {} while (false)
+#endif
+
+namespace tinyla::counters
+{
+    constexpr std::uint64_t snapshot::total(op op) const
+    {
+        std::uint64_t sum = 0;
+        for (auto c : m_counts[static_cast<std::size_t>(op)]) sum += c;
+        return sum;
+    }
+
+    constexpr snapshot operator-(snapshot const& later, snapshot const& earlier)
+    {
+        auto result = later;
+        for (std::size_t i = 0; i < result.m_counts.size(); ++i) {
+            for (std::size_t j = 0; j < result.m_counts[i].size(); ++j) {
+                result.m_counts[i][j] -= earlier.m_counts[i][j];
+            }
+        }
+        return result;
+    }
+
+    constexpr std::string_view name(op op)
+    {
+        constexpr auto names = std::array<std::string_view, static_cast<std::size_t>(op::count)>{
+            "mat_mul_mat",
+            "mat_mul_vec",
+            "mat_mul_mat_batched",
+            "determinant",
+            "inverted",
+            "normalize",
+            "normalized",
+            "pre_rotate_x",
+            "pre_rotate_y",
+            "pre_rotate_z",
+            "pre_rotate_axis",
+            "post_rotate_x",
+            "post_rotate_y",
+            "post_rotate_z",
+            "post_rotate_axis"
+        };
+        return names[static_cast<std::size_t>(op)];
+    }
+
+    constexpr std::string_view name(scalar scalar)
+    {
+        constexpr auto names = std::array<std::string_view, static_cast<std::size_t>(scalar::count)>{
+            "int", "float", "double", "long double", "other"
+        };
+        return names[static_cast<std::size_t>(scalar)];
+    }
+
+    template<typename T>
+    constexpr scalar scalar_of()
+    {
+        if constexpr (std::is_same_v<T, int>) return scalar::int_;
+        else if constexpr (std::is_same_v<T, float>) return scalar::float_;
+        else if constexpr (std::is_same_v<T, double>) return scalar::double_;
+        else if constexpr (std::is_same_v<T, long double>) return scalar::long_double_;
+        else return scalar::other;
+    }
+
+    inline snapshot take_snapshot()
+    {
+        return detail::thread_counters();
+    }
+
+    inline void reset()
+    {
+        detail::thread_counters() = snapshot{};
+    }
+
+    template<typename CharT, typename Traits>
+    void dump(std::basic_ostream<CharT, Traits>& os, snapshot const& snapshot)
+    {
+        for (std::size_t i = 0; i < static_cast<std::size_t>(op::count); ++i) {
+            for (std::size_t j = 0; j < static_cast<std::size_t>(scalar::count); ++j) {
+                auto const o = static_cast<op>(i);
+                auto const s = static_cast<scalar>(j);
+                if (snapshot[o, s] != 0) {
+                    os << name(o) << ' ' << name(s) << ' ' << snapshot[o, s] << '\n';
+                }
+            }
+        }
+    }
+
+    template<typename T>
+    void increment(op op, std::uint64_t n)
+    {
+        detail::thread_counters()[op, scalar_of<T>()] += n;
+    }
+
+    namespace detail {
+        inline snapshot& thread_counters()
+        {
+            thread_local auto counters = snapshot{};
+            return counters;
+        }
+    }
+}
+
+#endif // TINYLA_COUNTERS_HPP
@@ -0,0 +1,102 @@
+#ifndef TINYLA_EIGEN_HPP
+#define TINYLA_EIGEN_HPP
+
+#include <tinyla/mat.hpp>
+#include <tinyla/parallel.hpp>
+#include <tinyla/soa.hpp>
+#include <tinyla/vec.hpp>
+#include <bit>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+/**
+* Eigen-decomposition of symmetric 3x3 matrices and singular value decomposition of 3x3 matrices.
+*
+* Both run a fixed number of cyclic Jacobi sweeps, so that every matrix costs the same. The batched overloads
+* solve default_lanes<T> matrices side by side, one per SIMD lane, with selects in place of the branches of the
+* single-matrix versions and otherwise the same arithmetic. The SVD follows
+* McAdams et al., "Computing the Singular Value Decomposition of 3x3 matrices with minimal branching
+* and elementary floating point operations" (2011): V from the eigenvectors of A^T A, then U and the
+* singular values from a Givens QR decomposition of A V.
+*/
+
+namespace tinyla
+{
+    /**
+    * a = vectors * diag(values) * vectors^T, values in descending order;
+    * the columns of vectors are the eigenvectors and form a rotation.
+    */
+    template<typename T>
+    struct eigen3 {
+        vec<3,T> values;
+        mat<3,T> vectors;
+    };
+
+    /**
+    * a = u * diag(sigma) * v^T, where u and v are rotations, |sigma| is in descending order and only
+    * sigma[2] may be negative, namely when det(a) < 0.
+    */
+    template<typename T>
+    struct svd3 {
+        mat<3,T> u;
+        vec<3,T> sigma;
+        mat<3,T> v;
+    };
+
+    // a must be symmetric; only its upper triangle is read.
+    template<typename T>
+    constexpr eigen3<T> symmetric_eigen(mat<3,T> const& a);
+
+    template<typename T>
+    constexpr svd3<T> svd(mat<3,T> const& a);
+
+    template<typename T>
+    void symmetric_eigen(std::span<const mat<3,std::type_identity_t<T>>> as, std::span<eigen3<T>> out,
+                         parallel::options const& options = {});
+
+    template<typename T>
+    void svd(std::span<const mat<3,std::type_identity_t<T>>> as, std::span<svd3<T>> out,
+             parallel::options const& options = {});
+
+    namespace detail {
+        // Cyclic Jacobi converges quadratically; these reach full precision for any 3x3 input.
+        template<typename T>
+        constexpr std::size_t jacobi_sweeps = sizeof(T) <= 4 ? 5 : 8;
+
+        constexpr std::size_t eigen_block_size = 1024;
+
+        template<typename T>
+        constexpr void jacobi_rotate(mat<3,T>& s, mat<3,T>& v, std::size_t p, std::size_t q);
+
+        template<typename T>
+        constexpr void givens_qr_step(mat<3,T>& b, mat<3,T>& u, std::size_t p, std::size_t q, std::size_t column);
+
+        // L 3x3 matrices element by element: m[i][j][l] is the element in row i, column j of lane l.
+        template<typename T, std::size_t L>
+        struct mat3_lanes {
+            alignas(std::min<std::size_t>(std::bit_floor(L * sizeof(T)), 64)) T m[3][3][L];
+        };
+
+        // Square roots of all lanes; std::sqrt may set errno, which keeps compilers from vectorising it.
+        template<typename T, std::size_t L>
+        void sqrt_lanes(T (&x)[L]);
+
+        // The single-matrix algorithms on L lanes; s must be symmetric and is diagonalised in place.
+        template<typename T, std::size_t L>
+        void symmetric_eigen_lanes(mat3_lanes<T,L>& s, T (&values)[3][L], mat3_lanes<T,L>& v);
+
+        template<typename T, std::size_t L>
+        void svd_lanes(mat3_lanes<T,L> const& a, mat3_lanes<T,L>& u, T (&sigma)[3][L], mat3_lanes<T,L>& v);
+
+        template<std::size_t p, std::size_t q, typename T, std::size_t L>
+        void jacobi_rotate(mat3_lanes<T,L>& s, mat3_lanes<T,L>& v);
+
+        template<std::size_t p, std::size_t q, std::size_t column, typename T, std::size_t L>
+        void givens_qr_step(mat3_lanes<T,L>& b, mat3_lanes<T,L>& u);
+    }
+}
+
+#include "eigen.inl"
+
+#endif // TINYLA_EIGEN_HPP
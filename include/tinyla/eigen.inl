@@ -0,0 +1,375 @@
+#ifndef TINYLA_EIGEN_INL
+#define TINYLA_EIGEN_INL
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <utility>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define TINYLA_HAS_SIMD_SQRT
+#endif
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+
+namespace tinyla
+{
+    template<typename T>
+    constexpr eigen3<T> symmetric_eigen(mat<3,T> const& a)
+    {
+        auto s = a;
+        for (std::size_t i = 0; i < 3; ++i) {
+            for (std::size_t j = 0; j < i; ++j) s[i, j] = a[j, i];
+        }
+        auto v = mat<3,T>{mat_init::identity};
+
+        for (std::size_t sweep = 0; sweep < detail::jacobi_sweeps<T>; ++sweep) {
+            detail::jacobi_rotate(s, v, 0, 1);
+            detail::jacobi_rotate(s, v, 0, 2);
+            detail::jacobi_rotate(s, v, 1, 2);
+        }
+
+        auto result = eigen3<T>{vec<3,T>{s[0, 0], s[1, 1], s[2, 2]}, v};
+
+        // Sorting network of three compare-exchanges, swapping eigenvector columns with the values.
+        auto exchange = [&result](std::size_t i, std::size_t j) {
+            if (result.values[i] < result.values[j]) {
+                std::swap(result.values[i], result.values[j]);
+                for (std::size_t r = 0; r < 3; ++r) {
+                    T const t = result.vectors[r, i];
+                    result.vectors[r, i] = result.vectors[r, j];
+                    result.vectors[r, j] = t;
+                }
+            }
+        };
+        exchange(0, 1);
+        exchange(1, 2);
+        exchange(0, 1);
+
+        // Odd permutations make a reflection; flipping an eigenvector keeps it an eigenvector.
+        auto const& e = result.vectors;
+        T const det = e[0, 0] * (e[1, 1] * e[2, 2] - e[2, 1] * e[1, 2])
+                    - e[0, 1] * (e[1, 0] * e[2, 2] - e[2, 0] * e[1, 2])
+                    + e[0, 2] * (e[1, 0] * e[2, 1] - e[2, 0] * e[1, 1]);
+        if (det < T{0}) {
+            for (std::size_t r = 0; r < 3; ++r) result.vectors[r, 2] = -result.vectors[r, 2];
+        }
+        return result;
+    }
+
+    template<typename T>
+    constexpr svd3<T> svd(mat<3,T> const& a)
+    {
+        auto const v = symmetric_eigen(a.transposed() * a).vectors;
+
+        // Columns of b = a v are orthogonal with norms sorted like the eigenvalues; QR makes b upper triangular.
+        auto b = a * v;
+        auto u = mat<3,T>{mat_init::identity};
+        detail::givens_qr_step(b, u, 0, 1, 0);
+        detail::givens_qr_step(b, u, 0, 2, 0);
+        detail::givens_qr_step(b, u, 1, 2, 1);
+
+        return svd3<T>{u, vec<3,T>{b[0, 0], b[1, 1], b[2, 2]}, v};
+    }
+
+    template<typename T>
+    void symmetric_eigen(std::span<const mat<3,std::type_identity_t<T>>> as, std::span<eigen3<T>> out,
+                         parallel::options const& options)
+    {
+        assert(as.size() == out.size());
+        constexpr auto L = default_lanes<T>;
+        parallel::for_each_block(as.size(), detail::eigen_block_size, [&](std::size_t, std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; i += L) {
+                auto const n = std::min(L, last - i);
+                // Unused lanes hold zero matrices.
+                auto s = detail::mat3_lanes<T,L>{};
+                for (std::size_t l = 0; l < n; ++l) {
+                    for (std::size_t r = 0; r < 3; ++r) {
+                        for (std::size_t c = 0; c < 3; ++c) s.m[r][c][l] = as[i + l][std::min(r, c), std::max(r, c)];
+                    }
+                }
+                T values[3][L];
+                auto v = detail::mat3_lanes<T,L>{};
+                detail::symmetric_eigen_lanes(s, values, v);
+                for (std::size_t l = 0; l < n; ++l) {
+                    auto& e = out[i + l];
+                    for (std::size_t r = 0; r < 3; ++r) {
+                        e.values[r] = values[r][l];
+                        for (std::size_t c = 0; c < 3; ++c) e.vectors[r, c] = v.m[r][c][l];
+                    }
+                }
+            }
+        }, options);
+    }
+
+    template<typename T>
+    void svd(std::span<const mat<3,std::type_identity_t<T>>> as, std::span<svd3<T>> out,
+             parallel::options const& options)
+    {
+        assert(as.size() == out.size());
+        constexpr auto L = default_lanes<T>;
+        parallel::for_each_block(as.size(), detail::eigen_block_size, [&](std::size_t, std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; i += L) {
+                auto const n = std::min(L, last - i);
+                auto a = detail::mat3_lanes<T,L>{};
+                for (std::size_t l = 0; l < n; ++l) {
+                    for (std::size_t r = 0; r < 3; ++r) {
+                        for (std::size_t c = 0; c < 3; ++c) a.m[r][c][l] = as[i + l][r, c];
+                    }
+                }
+                auto u = detail::mat3_lanes<T,L>{};
+                T sigma[3][L];
+                auto v = detail::mat3_lanes<T,L>{};
+                detail::svd_lanes(a, u, sigma, v);
+                for (std::size_t l = 0; l < n; ++l) {
+                    auto& d = out[i + l];
+                    for (std::size_t r = 0; r < 3; ++r) {
+                        d.sigma[r] = sigma[r][l];
+                        for (std::size_t c = 0; c < 3; ++c) {
+                            d.u[r, c] = u.m[r][c][l];
+                            d.v[r, c] = v.m[r][c][l];
+                        }
+                    }
+                }
+            }
+        }, options);
+    }
+
+    namespace detail {
+        template<typename T>
+        constexpr void jacobi_rotate(mat<3,T>& s, mat<3,T>& v, std::size_t p, std::size_t q)
+        {
+            // Rotation in the (p, q) plane that zeroes s[p, q] (Golub and Van Loan, Algorithm 8.5.1).
+            T const spq = s[p, q];
+            bool const skip = spq == T{0};
+            T const theta = (s[q, q] - s[p, p]) / (T{2} * (skip ? T{1} : spq));
+            T const t = skip ? T{0} : (theta < T{0} ? T{-1} : T{1}) / (tinyla::abs(theta) + tinyla::sqrt(theta * theta + T{1}));
+            T const c = T{1} / tinyla::sqrt(t * t + T{1});
+            T const sn = t * c;
+
+            auto const r = 3 - p - q;
+            T const srp = s[r, p];
+            T const srq = s[r, q];
+            s[p, p] -= t * spq;
+            s[q, q] += t * spq;
+            s[p, q] = s[q, p] = T{0};
+            s[r, p] = s[p, r] = c * srp - sn * srq;
+            s[r, q] = s[q, r] = sn * srp + c * srq;
+
+            for (std::size_t k = 0; k < 3; ++k) {
+                T const vkp = v[k, p];
+                T const vkq = v[k, q];
+                v[k, p] = c * vkp - sn * vkq;
+                v[k, q] = sn * vkp + c * vkq;
+            }
+        }
+
+        template<typename T>
+        constexpr void givens_qr_step(mat<3,T>& b, mat<3,T>& u, std::size_t p, std::size_t q, std::size_t column)
+        {
+            // Rotation of rows p and q that zeroes b[q, column] against b[p, column]; u accumulates its transpose.
+            T const x = b[p, column];
+            T const y = b[q, column];
+            T const r = tinyla::sqrt(x * x + y * y);
+            bool const zero = r == T{0};
+            T const c = zero ? T{1} : x / r;
+            T const s = zero ? T{0} : y / r;
+
+            for (std::size_t k = 0; k < 3; ++k) {
+                T const bp = b[p, k];
+                T const bq = b[q, k];
+                b[p, k] = c * bp + s * bq;
+                b[q, k] = -s * bp + c * bq;
+
+                T const up = u[k, p];
+                T const uq = u[k, q];
+                u[k, p] = c * up + s * uq;
+                u[k, q] = -s * up + c * uq;
+            }
+        }
+
+        template<typename T, std::size_t L>
+        void sqrt_lanes(T (&x)[L])
+        {
+            std::size_t l = 0;
+#ifdef TINYLA_HAS_SIMD_SQRT
+            if constexpr (std::is_same_v<T, float>) {
+#ifdef __AVX__
+                for (; l + 8 <= L; l += 8) _mm256_storeu_ps(x + l, _mm256_sqrt_ps(_mm256_loadu_ps(x + l)));
+#endif
+                for (; l + 4 <= L; l += 4) _mm_storeu_ps(x + l, _mm_sqrt_ps(_mm_loadu_ps(x + l)));
+            } else if constexpr (std::is_same_v<T, double>) {
+#ifdef __AVX__
+                for (; l + 4 <= L; l += 4) _mm256_storeu_pd(x + l, _mm256_sqrt_pd(_mm256_loadu_pd(x + l)));
+#endif
+                for (; l + 2 <= L; l += 2) _mm_storeu_pd(x + l, _mm_sqrt_pd(_mm_loadu_pd(x + l)));
+            }
+#endif
+            for (; l < L; ++l) x[l] = std::sqrt(x[l]);
+        }
+
+        template<typename T, std::size_t L>
+        void symmetric_eigen_lanes(mat3_lanes<T,L>& s, T (&values)[3][L], mat3_lanes<T,L>& v)
+        {
+            v = mat3_lanes<T,L>{};
+            for (std::size_t r = 0; r < 3; ++r) {
+                for (std::size_t l = 0; l < L; ++l) v.m[r][r][l] = T{1};
+            }
+
+            for (std::size_t sweep = 0; sweep < jacobi_sweeps<T>; ++sweep) {
+                jacobi_rotate<0, 1>(s, v);
+                jacobi_rotate<0, 2>(s, v);
+                jacobi_rotate<1, 2>(s, v);
+            }
+
+            for (std::size_t r = 0; r < 3; ++r) {
+                for (std::size_t l = 0; l < L; ++l) values[r][l] = s.m[r][r][l];
+            }
+
+            auto exchange = [&values, &v](std::size_t i, std::size_t j) {
+                for (std::size_t l = 0; l < L; ++l) {
+                    bool const swap = values[i][l] < values[j][l];
+                    T const vi = values[i][l];
+                    T const vj = values[j][l];
+                    values[i][l] = swap ? vj : vi;
+                    values[j][l] = swap ? vi : vj;
+                    for (std::size_t r = 0; r < 3; ++r) {
+                        T const ei = v.m[r][i][l];
+                        T const ej = v.m[r][j][l];
+                        v.m[r][i][l] = swap ? ej : ei;
+                        v.m[r][j][l] = swap ? ei : ej;
+                    }
+                }
+            };
+            exchange(0, 1);
+            exchange(1, 2);
+            exchange(0, 1);
+
+            auto const& e = v.m;
+            for (std::size_t l = 0; l < L; ++l) {
+                T const det = e[0][0][l] * (e[1][1][l] * e[2][2][l] - e[2][1][l] * e[1][2][l])
+                            - e[0][1][l] * (e[1][0][l] * e[2][2][l] - e[2][0][l] * e[1][2][l])
+                            + e[0][2][l] * (e[1][0][l] * e[2][1][l] - e[2][0][l] * e[1][1][l]);
+                T const sign = det < T{0} ? T{-1} : T{1};
+                for (std::size_t r = 0; r < 3; ++r) v.m[r][2][l] *= sign;
+            }
+        }
+
+        template<typename T, std::size_t L>
+        void svd_lanes(mat3_lanes<T,L> const& a, mat3_lanes<T,L>& u, T (&sigma)[3][L], mat3_lanes<T,L>& v)
+        {
+            // a^T a, summed in the order of the single-matrix product.
+            auto s = mat3_lanes<T,L>{};
+            for (std::size_t r = 0; r < 3; ++r) {
+                for (std::size_t c = r; c < 3; ++c) {
+                    for (std::size_t l = 0; l < L; ++l) {
+                        T sum = T{0};
+                        for (std::size_t k = 0; k < 3; ++k) sum += a.m[k][r][l] * a.m[k][c][l];
+                        s.m[r][c][l] = s.m[c][r][l] = sum;
+                    }
+                }
+            }
+            T values[3][L];
+            symmetric_eigen_lanes(s, values, v);
+
+            auto b = mat3_lanes<T,L>{};
+            for (std::size_t r = 0; r < 3; ++r) {
+                for (std::size_t c = 0; c < 3; ++c) {
+                    for (std::size_t l = 0; l < L; ++l) {
+                        T sum = T{0};
+                        for (std::size_t k = 0; k < 3; ++k) sum += a.m[r][k][l] * v.m[k][c][l];
+                        b.m[r][c][l] = sum;
+                    }
+                }
+            }
+            u = mat3_lanes<T,L>{};
+            for (std::size_t r = 0; r < 3; ++r) {
+                for (std::size_t l = 0; l < L; ++l) u.m[r][r][l] = T{1};
+            }
+            givens_qr_step<0, 1, 0>(b, u);
+            givens_qr_step<0, 2, 0>(b, u);
+            givens_qr_step<1, 2, 1>(b, u);
+
+            for (std::size_t r = 0; r < 3; ++r) {
+                for (std::size_t l = 0; l < L; ++l) sigma[r][l] = b.m[r][r][l];
+            }
+        }
+
+        template<std::size_t p, std::size_t q, typename T, std::size_t L>
+        void jacobi_rotate(mat3_lanes<T,L>& s, mat3_lanes<T,L>& v)
+        {
+            // As the single-matrix rotation, with the square roots in passes of their own and the divisions
+            // guarded by 0/1 masks rather than selects, which the compiler would turn back into branches.
+            T theta[L];
+            T t[L];
+            T c[L];
+            for (std::size_t l = 0; l < L; ++l) {
+                T const spq = s.m[p][q][l];
+                T const skip = spq == T{0} ? T{1} : T{0};
+                theta[l] = (s.m[q][q][l] - s.m[p][p][l]) / (T{2} * (spq + skip));
+                t[l] = theta[l] * theta[l] + T{1};
+            }
+            sqrt_lanes(t);
+            for (std::size_t l = 0; l < L; ++l) {
+                T const sign = s.m[p][q][l] == T{0} ? T{0} : (theta[l] < T{0} ? T{-1} : T{1});
+                t[l] = sign / (std::abs(theta[l]) + t[l]);
+                c[l] = t[l] * t[l] + T{1};
+            }
+            sqrt_lanes(c);
+
+            constexpr auto r = 3 - p - q;
+            for (std::size_t l = 0; l < L; ++l) {
+                T const cl = T{1} / c[l];
+                T const sn = t[l] * cl;
+                T const spq = s.m[p][q][l];
+                T const srp = s.m[r][p][l];
+                T const srq = s.m[r][q][l];
+                s.m[p][p][l] -= t[l] * spq;
+                s.m[q][q][l] += t[l] * spq;
+                s.m[p][q][l] = s.m[q][p][l] = T{0};
+                s.m[r][p][l] = s.m[p][r][l] = cl * srp - sn * srq;
+                s.m[r][q][l] = s.m[q][r][l] = sn * srp + cl * srq;
+
+                for (std::size_t k = 0; k < 3; ++k) {
+                    T const vkp = v.m[k][p][l];
+                    T const vkq = v.m[k][q][l];
+                    v.m[k][p][l] = cl * vkp - sn * vkq;
+                    v.m[k][q][l] = sn * vkp + cl * vkq;
+                }
+            }
+        }
+
+        template<std::size_t p, std::size_t q, std::size_t column, typename T, std::size_t L>
+        void givens_qr_step(mat3_lanes<T,L>& b, mat3_lanes<T,L>& u)
+        {
+            T r[L];
+            for (std::size_t l = 0; l < L; ++l) {
+                T const x = b.m[p][column][l];
+                T const y = b.m[q][column][l];
+                r[l] = x * x + y * y;
+            }
+            sqrt_lanes(r);
+
+            for (std::size_t l = 0; l < L; ++l) {
+                T const zero = r[l] == T{0} ? T{1} : T{0};
+                T const c = (b.m[p][column][l] * (T{1} - zero) + zero) / (r[l] + zero);
+                T const s = (b.m[q][column][l] * (T{1} - zero)) / (r[l] + zero);
+
+                for (std::size_t k = 0; k < 3; ++k) {
+                    T const bp = b.m[p][k][l];
+                    T const bq = b.m[q][k][l];
+                    b.m[p][k][l] = c * bp + s * bq;
+                    b.m[q][k][l] = -s * bp + c * bq;
+
+                    T const up = u.m[k][p][l];
+                    T const uq = u.m[k][q][l];
+                    u.m[k][p][l] = c * up + s * uq;
+                    u.m[k][q][l] = -s * up + c * uq;
+                }
+            }
+        }
+    }
+}
+
+#endif // TINYLA_EIGEN_INL
@@ -0,0 +1,215 @@
+#ifndef TINYLA_FIXED_HPP
+#define TINYLA_FIXED_HPP
+
+#include <tinyla/util.hpp>
+#include <array>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <span>
+#include <type_traits>
+
+/**
+* Binary fixed-point numbers, for results that are bit-identical across compilers, platforms and
+* floating-point settings (FMA contraction, x87, fast-math).
+*
+* fixed<Rep, F> stores x * 2^F rounded to an integer of type Rep: q16_16 in 32 bits, q32_32 in 64 bits.
+* Addition and subtraction wrap on overflow, multiplication rounds to nearest and division truncates
+* towards zero. sqrt, sin, cos and tan only use integer arithmetic, so fixed can stand in for float as the
+* scalar of vec, mat and the geom builders, with the same results at compile time and at run time.
+*/
+
+namespace tinyla
+{
+    namespace detail {
+        // Integer types wide enough for the product of two Reps.
+        template<typename Rep>
+        struct fixed_wide;
+
+        template<>
+        struct fixed_wide<std::int32_t> {
+            using type = std::int64_t;
+            using unsigned_type = std::uint64_t;
+        };
+
+#if defined(__SIZEOF_INT128__)
+        template<>
+        struct fixed_wide<std::int64_t> {
+            __extension__ typedef __int128 type;
+            __extension__ typedef unsigned __int128 unsigned_type;
+        };
+#endif
+    }
+
+    template<typename Rep, int F>
+    class fixed {
+        static_assert(std::is_same_v<Rep, std::int32_t> || std::is_same_v<Rep, std::int64_t>);
+        static_assert(0 < F && F < std::numeric_limits<Rep>::digits);
+    public:
+        using rep = Rep;
+        using wide = typename detail::fixed_wide<Rep>::type;
+        static constexpr int fractional_bits = F;
+
+        constexpr fixed() noexcept = default;
+
+        template<std::integral I>
+        constexpr explicit fixed(I n) noexcept;
+
+        // Rounded to nearest; x must be in range.
+        template<std::floating_point U>
+        constexpr explicit fixed(U x) noexcept;
+
+        static constexpr fixed from_raw(Rep raw) noexcept;
+        constexpr Rep raw() const noexcept { return m_raw; }
+
+        template<std::floating_point U>
+        constexpr explicit operator U() const noexcept;
+
+        // Truncated towards zero.
+        template<std::integral I>
+        constexpr explicit operator I() const noexcept;
+
+        constexpr fixed& operator+=(fixed rhs) noexcept;
+        constexpr fixed& operator-=(fixed rhs) noexcept;
+        constexpr fixed& operator*=(fixed rhs) noexcept;
+        constexpr fixed& operator/=(fixed rhs) noexcept;
+
+        constexpr fixed operator-() const noexcept;
+        constexpr fixed operator+() const noexcept { return *this; }
+
+        friend constexpr fixed operator+(fixed a, fixed b) noexcept { return a += b; }
+        friend constexpr fixed operator-(fixed a, fixed b) noexcept { return a -= b; }
+        friend constexpr fixed operator*(fixed a, fixed b) noexcept { return a *= b; }
+        friend constexpr fixed operator/(fixed a, fixed b) noexcept { return a /= b; }
+
+        // Scaling by an integer is exact (up to wrap-around) for *, truncated for /.
+        template<std::integral I>
+        friend constexpr fixed operator*(fixed a, I n) noexcept { return from_raw(wrapping_multiply(a.m_raw, n)); }
+        template<std::integral I>
+        friend constexpr fixed operator*(I n, fixed a) noexcept { return from_raw(wrapping_multiply(a.m_raw, n)); }
+        template<std::integral I>
+        friend constexpr fixed operator/(fixed a, I n) noexcept
+        {
+            return from_raw(static_cast<Rep>(static_cast<wide>(a.m_raw) / static_cast<wide>(n)));
+        }
+
+        friend constexpr bool operator==(fixed a, fixed b) noexcept = default;
+        friend constexpr auto operator<=>(fixed a, fixed b) noexcept = default;
+    private:
+        template<std::integral I>
+        static constexpr Rep wrapping_multiply(Rep raw, I n) noexcept;
+
+        Rep m_raw = 0;
+    };
+
+    using q16_16 = fixed<std::int32_t, 16>;
+#if defined(__SIZEOF_INT128__)
+    using q32_32 = fixed<std::int64_t, 32>;
+#endif
+
+    template<typename Rep, int F>
+    constexpr fixed<Rep,F> abs(fixed<Rep,F> x);
+
+    // Rounded to nearest; x must not be negative.
+    template<typename Rep, int F>
+    constexpr fixed<Rep,F> sqrt(fixed<Rep,F> x);
+
+    /**
+    * sin and cos from a quarter-wave table of 1024 segments, corrected by a third-order Taylor step within
+    * the segment; accurate to a few units of the last place near zero, losing about half a unit more per
+    * turn of |x| to the rounding of 2 pi.
+    */
+    template<typename Rep, int F>
+    constexpr sincos_result<fixed<Rep,F>> sincos(fixed<Rep,F> x);
+
+    template<typename Rep, int F>
+    constexpr fixed<Rep,F> sin(fixed<Rep,F> x);
+
+    template<typename Rep, int F>
+    constexpr fixed<Rep,F> cos(fixed<Rep,F> x);
+
+    template<typename Rep, int F>
+    constexpr fixed<Rep,F> tan(fixed<Rep,F> x);
+
+    // Within one unit of the last place.
+    template<typename Rep, int F>
+    constexpr bool close(fixed<Rep,F> n1, fixed<Rep,F> n2);
+
+    template<typename Rep, int F>
+    constexpr bool close_to_zero(fixed<Rep,F> n);
+
+    /**
+    * Bulk kernels with the same rounding as the scalar operators, so the results match element for element.
+    * They are plain loops over the raw integers, which compilers vectorise (pmuldq / vpmuldq for q16_16).
+    * out may be the same range as an input.
+    */
+
+    // out[i] = a[i] * b[i]
+    template<typename Rep, int F>
+    void multiply(std::span<const fixed<Rep,F>> a, std::span<const fixed<Rep,F>> b, std::span<fixed<Rep,F>> out);
+
+    // out[i] = a[i] * s + b[i]
+    template<typename Rep, int F>
+    void multiply_add(std::span<const fixed<Rep,F>> a, fixed<Rep,F> s, std::span<const fixed<Rep,F>> b,
+                          std::span<fixed<Rep,F>> out);
+
+    // out[i] = xs[i] * ys[i] + ... for the components of structure-of-arrays 3D vectors, as dot(vec, vec).
+    template<typename Rep, int F>
+    void dot_soa(std::span<const fixed<Rep,F>> x1, std::span<const fixed<Rep,F>> y1, std::span<const fixed<Rep,F>> z1,
+                 std::span<const fixed<Rep,F>> x2, std::span<const fixed<Rep,F>> y2, std::span<const fixed<Rep,F>> z2,
+                 std::span<fixed<Rep,F>> out);
+
+    namespace detail {
+        template<typename Rep, int F>
+        constexpr Rep fixed_multiply(Rep a, Rep b);
+
+        // Segments of the quarter-wave sine table.
+        constexpr std::size_t fixed_sine_segments = 1024;
+
+        // sin(k * pi / 2 / fixed_sine_segments) for k = 0..fixed_sine_segments, in raw units.
+        template<typename Rep, int F>
+        constexpr std::array<Rep, fixed_sine_segments + 1> make_fixed_sine_table();
+
+        template<typename Rep, int F>
+        inline constexpr auto fixed_sine_table = make_fixed_sine_table<Rep,F>();
+    }
+}
+
+namespace std
+{
+    template<typename Rep, int F>
+    class numeric_limits<tinyla::fixed<Rep,F>> {
+        using fixed = tinyla::fixed<Rep,F>;
+    public:
+        static constexpr bool is_specialized = true;
+        static constexpr bool is_signed = true;
+        static constexpr bool is_integer = false;
+        static constexpr bool is_exact = true;
+        static constexpr bool has_infinity = false;
+        static constexpr bool has_quiet_NaN = false;
+        static constexpr bool has_signaling_NaN = false;
+        static constexpr bool is_modulo = true;
+        static constexpr int radix = 2;
+        static constexpr int digits = std::numeric_limits<Rep>::digits;
+
+        // Smallest positive value, as for floating-point types.
+        static constexpr fixed min() noexcept { return fixed::from_raw(1); }
+        static constexpr fixed max() noexcept { return fixed::from_raw(std::numeric_limits<Rep>::max()); }
+        static constexpr fixed lowest() noexcept { return fixed::from_raw(std::numeric_limits<Rep>::lowest()); }
+        static constexpr fixed epsilon() noexcept { return fixed::from_raw(1); }
+        static constexpr fixed round_error() noexcept { return fixed::from_raw(Rep{1} << (F - 1)); }
+    };
+}
+
+namespace std::numbers
+{
+    template<typename Rep, int F>
+    inline constexpr tinyla::fixed<Rep,F> pi_v<tinyla::fixed<Rep,F>> = tinyla::fixed<Rep,F>{pi_v<double>};
+}
+
+#include "fixed.inl"
+
+#endif // TINYLA_FIXED_HPP
@@ -0,0 +1,250 @@
+#ifndef TINYLA_FIXED_INL
+#define TINYLA_FIXED_INL
+
+#include <cassert>
+
+namespace tinyla
+{
+    template<typename Rep, int F>
+    template<std::integral I>
+    constexpr fixed<Rep,F>::fixed(I n) noexcept
+        : m_raw{static_cast<Rep>(static_cast<wide>(n) * (wide{1} << F))}
+    {
+    }
+
+    template<typename Rep, int F>
+    template<std::floating_point U>
+    constexpr fixed<Rep,F>::fixed(U x) noexcept
+    {
+        auto const scaled = static_cast<double>(x) * static_cast<double>(std::uint64_t{1} << F);
+        m_raw = static_cast<Rep>(scaled < 0.0 ? scaled - 0.5 : scaled + 0.5);
+    }
+
+    template<typename Rep, int F>
+    constexpr fixed<Rep,F> fixed<Rep,F>::from_raw(Rep raw) noexcept
+    {
+        fixed result;
+        result.m_raw = raw;
+        return result;
+    }
+
+    template<typename Rep, int F>
+    template<std::floating_point U>
+    constexpr fixed<Rep,F>::operator U() const noexcept
+    {
+        return static_cast<U>(static_cast<double>(m_raw) / static_cast<double>(std::uint64_t{1} << F));
+    }
+
+    template<typename Rep, int F>
+    template<std::integral I>
+    constexpr fixed<Rep,F>::operator I() const noexcept
+    {
+        return static_cast<I>(m_raw / (Rep{1} << F));
+    }
+
+    template<typename Rep, int F>
+    constexpr fixed<Rep,F>& fixed<Rep,F>::operator+=(fixed rhs) noexcept
+    {
+        using U = std::make_unsigned_t<Rep>;
+        m_raw = static_cast<Rep>(static_cast<U>(m_raw) + static_cast<U>(rhs.m_raw));
+        return *this;
+    }
+
+    template<typename Rep, int F>
+    constexpr fixed<Rep,F>& fixed<Rep,F>::operator-=(fixed rhs) noexcept
+    {
+        using U = std::make_unsigned_t<Rep>;
+        m_raw = static_cast<Rep>(static_cast<U>(m_raw) - static_cast<U>(rhs.m_raw));
+        return *this;
+    }
+
+    template<typename Rep, int F>
+    constexpr fixed<Rep,F>& fixed<Rep,F>::operator*=(fixed rhs) noexcept
+    {
+        m_raw = detail::fixed_multiply<Rep,F>(m_raw, rhs.m_raw);
+        return *this;
+    }
+
+    template<typename Rep, int F>
+    constexpr fixed<Rep,F>& fixed<Rep,F>::operator/=(fixed rhs) noexcept
+    {
+        assert(rhs.m_raw != 0);
+        m_raw = static_cast<Rep>((static_cast<wide>(m_raw) << F) / rhs.m_raw);
+        return *this;
+    }
+
+    template<typename Rep, int F>
+    constexpr fixed<Rep,F> fixed<Rep,F>::operator-() const noexcept
+    {
+        using U = std::make_unsigned_t<Rep>;
+        return from_raw(static_cast<Rep>(U{0} - static_cast<U>(m_raw)));
+    }
+
+    template<typename Rep, int F>
+    template<std::integral I>
+    constexpr Rep fixed<Rep,F>::wrapping_multiply(Rep raw, I n) noexcept
+    {
+        using U = std::make_unsigned_t<Rep>;
+        return static_cast<Rep>(static_cast<U>(raw) * static_cast<U>(n));
+    }
+
+    template<typename Rep, int F>
+    constexpr fixed<Rep,F> abs(fixed<Rep,F> x)
+    {
+        return x.raw() < 0 ? -x : x;
+    }
+
+    template<typename Rep, int F>
+    constexpr fixed<Rep,F> sqrt(fixed<Rep,F> x)
+    {
+        assert(x.raw() >= 0);
+        using U = typename detail::fixed_wide<Rep>::unsigned_type;
+
+        // Digit-by-digit integer square root of raw * 2^F, rounded to nearest.
+        auto n = static_cast<U>(x.raw()) << F;
+        U result = 0;
+        U bit = U{1} << (std::numeric_limits<U>::digits - 2);
+        while (bit > n) bit >>= 2;
+        while (bit != 0) {
+            if (n >= result + bit) {
+                n -= result + bit;
+                result = (result >> 1) + bit;
+            } else {
+                result >>= 1;
+            }
+            bit >>= 2;
+        }
+        if (n > result) ++result;
+        return fixed<Rep,F>::from_raw(static_cast<Rep>(result));
+    }
+
+    template<typename Rep, int F>
+    constexpr sincos_result<fixed<Rep,F>> sincos(fixed<Rep,F> x)
+    {
+        using fixed = tinyla::fixed<Rep,F>;
+        using wide = typename fixed::wide;
+        constexpr auto segments = static_cast<wide>(detail::fixed_sine_segments);
+        constexpr auto turn = fixed{2.0 * std::numbers::pi}.raw();
+        auto const& table = detail::fixed_sine_table<Rep,F>;
+
+        // x = (turns + index / (4 * segments)) * 2 pi + d, with 0 <= d < one segment.
+        auto r = static_cast<Rep>(x.raw() % turn);
+        if (r < 0) r += turn;
+        auto const index = static_cast<wide>(r) * (4 * segments) / turn;
+        auto const start = static_cast<wide>(index * turn / (4 * segments));
+        auto const d = fixed::from_raw(static_cast<Rep>(r - start));
+
+        auto const quadrant = static_cast<int>(index / segments);
+        auto const k = static_cast<std::size_t>(index % segments);
+        auto const s0 = fixed::from_raw(table[k]);
+        auto const c0 = fixed::from_raw(table[detail::fixed_sine_segments - k]);
+
+        // sin(a + d) and cos(a + d) with cos d = 1 - d^2 / 2 and sin d = d - d^3 / 6.
+        auto const d2 = d * d;
+        auto const cd = fixed{1} - d2 / 2;
+        auto const sd = d - d * d2 / 6;
+        auto const s = s0 * cd + c0 * sd;
+        auto const c = c0 * cd - s0 * sd;
+        switch (quadrant) {
+            case 0: return {s, c};
+            case 1: return {c, -s};
+            case 2: return {-s, -c};
+            default: return {-c, s};
+        }
+    }
+
+    template<typename Rep, int F>
+    constexpr fixed<Rep,F> sin(fixed<Rep,F> x)
+    {
+        return sincos(x).sin;
+    }
+
+    template<typename Rep, int F>
+    constexpr fixed<Rep,F> cos(fixed<Rep,F> x)
+    {
+        return sincos(x).cos;
+    }
+
+    template<typename Rep, int F>
+    constexpr fixed<Rep,F> tan(fixed<Rep,F> x)
+    {
+        auto const sc = sincos(x);
+        return sc.sin / sc.cos;
+    }
+
+    template<typename Rep, int F>
+    constexpr bool close(fixed<Rep,F> n1, fixed<Rep,F> n2)
+    {
+        return tinyla::abs(n1 - n2) <= std::numeric_limits<fixed<Rep,F>>::epsilon();
+    }
+
+    template<typename Rep, int F>
+    constexpr bool close_to_zero(fixed<Rep,F> n)
+    {
+        return tinyla::abs(n) <= std::numeric_limits<fixed<Rep,F>>::epsilon();
+    }
+
+    template<typename Rep, int F>
+    void multiply(std::span<const fixed<Rep,F>> a, std::span<const fixed<Rep,F>> b, std::span<fixed<Rep,F>> out)
+    {
+        assert(a.size() == b.size() && a.size() == out.size());
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            out[i] = fixed<Rep,F>::from_raw(detail::fixed_multiply<Rep,F>(a[i].raw(), b[i].raw()));
+        }
+    }
+
+    template<typename Rep, int F>
+    void multiply_add(std::span<const fixed<Rep,F>> a, fixed<Rep,F> s, std::span<const fixed<Rep,F>> b,
+                          std::span<fixed<Rep,F>> out)
+    {
+        assert(a.size() == b.size() && a.size() == out.size());
+        using U = std::make_unsigned_t<Rep>;
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            auto const p = detail::fixed_multiply<Rep,F>(a[i].raw(), s.raw());
+            out[i] = fixed<Rep,F>::from_raw(static_cast<Rep>(static_cast<U>(p) + static_cast<U>(b[i].raw())));
+        }
+    }
+
+    template<typename Rep, int F>
+    void dot_soa(std::span<const fixed<Rep,F>> x1, std::span<const fixed<Rep,F>> y1, std::span<const fixed<Rep,F>> z1,
+                 std::span<const fixed<Rep,F>> x2, std::span<const fixed<Rep,F>> y2, std::span<const fixed<Rep,F>> z2,
+                 std::span<fixed<Rep,F>> out)
+    {
+        auto const n = out.size();
+        assert(x1.size() == n && y1.size() == n && z1.size() == n);
+        assert(x2.size() == n && y2.size() == n && z2.size() == n);
+        using U = std::make_unsigned_t<Rep>;
+        for (std::size_t i = 0; i < n; ++i) {
+            auto const x = static_cast<U>(detail::fixed_multiply<Rep,F>(x1[i].raw(), x2[i].raw()));
+            auto const y = static_cast<U>(detail::fixed_multiply<Rep,F>(y1[i].raw(), y2[i].raw()));
+            auto const z = static_cast<U>(detail::fixed_multiply<Rep,F>(z1[i].raw(), z2[i].raw()));
+            out[i] = fixed<Rep,F>::from_raw(static_cast<Rep>(x + y + z));
+        }
+    }
+
+    namespace detail {
+        template<typename Rep, int F>
+        constexpr Rep fixed_multiply(Rep a, Rep b)
+        {
+            using wide = typename fixed_wide<Rep>::type;
+            auto const p = static_cast<wide>(a) * static_cast<wide>(b);
+            return static_cast<Rep>((p + (wide{1} << (F - 1))) >> F);
+        }
+
+        template<typename Rep, int F>
+        constexpr std::array<Rep, fixed_sine_segments + 1> make_fixed_sine_table()
+        {
+            // Evaluated once, at compile time, by the portable series in util.hpp.
+            std::array<Rep, fixed_sine_segments + 1> table{};
+            constexpr auto quarter = std::numbers::pi / 2.0;
+            for (std::size_t k = 0; k <= fixed_sine_segments; ++k) {
+                auto const a = quarter * static_cast<double>(k) / static_cast<double>(fixed_sine_segments);
+                auto const s = a <= quarter / 2.0 ? sin_series(a) : cos_series(quarter - a);
+                table[k] = fixed<Rep,F>{s}.raw();
+            }
+            return table;
+        }
+    }
+}
+
+#endif // TINYLA_FIXED_INL
@@ -1,9 +1,14 @@
 #ifndef TINYLA_GEOM_HPP
 #define TINYLA_GEOM_HPP
 
+#include <tinyla/batch.hpp>
 #include <tinyla/mat.hpp>
+#include <array>
 #include <cstddef>
+#include <limits>
 #include <numbers>
+#include <span>
+#include <type_traits>
 
 namespace tinyla {
     template<std::size_t N, typename T>
@@ -17,14 +22,43 @@ namespace tinyla::geom {
     public:
         constexpr static angle from_radians(T radians);
         constexpr static angle from_degrees(T degrees);
-        T radians() const { return m_radians; }
+        constexpr T radians() const { return m_radians; }
         // Unary minus (negation)
-        constexpr angle operator-() noexcept { return angle{-m_radians}; }
+        constexpr angle operator-() const noexcept { return angle{-m_radians}; }
     private:
         explicit constexpr angle(T r) : m_radians{r} {}
         T m_radians;
     };
 
+    /**
+    * An angle with its sine and cosine computed once, for angles passed to several builders.
+    */
+    template<typename T>
+    class cached_angle {
+    public:
+        constexpr explicit cached_angle(angle<T> const& a);
+        constexpr T radians() const { return m_radians; }
+        constexpr T sin() const { return m_sin; }
+        constexpr T cos() const { return m_cos; }
+        constexpr angle<T> uncached() const { return angle<T>::from_radians(m_radians); }
+        // Unary minus (negation)
+        constexpr cached_angle operator-() const noexcept { return cached_angle{-m_radians, -m_sin, m_cos}; }
+
+        template<typename U>
+        friend void sincos(std::span<const angle<std::type_identity_t<U>>> angles, std::span<cached_angle<U>> out);
+    private:
+        constexpr cached_angle(T r, T s, T c) : m_radians{r}, m_sin{s}, m_cos{c} {}
+        T m_radians;
+        T m_sin;
+        T m_cos;
+    };
+
+    /**
+    * out[i] = cached_angle{angles[i]}, with the sines and cosines computed by the vectorised tinyla::sincos kernel.
+    */
+    template<typename T>
+    void sincos(std::span<const angle<std::type_identity_t<T>>> angles, std::span<cached_angle<T>> out);
+
     namespace literals {
         constexpr angle<float> operator ""_radf(long double n)
         {
@@ -64,14 +98,19 @@ namespace tinyla::geom {
         minus_one_to_one    // OpenGL
     };
 
+    enum class decomposition {
+        orthogonal, // the upper 3x3 block is a rotation times a scaling
+        polar       // any shear is projected out by the polar decomposition
+    };
+
     template<typename T>
     class frustum {
     public:
         constexpr frustum(angle<T> const& fov, T ar, T z_near, T z_far);
-        angle<T> const& fov() const { return m_fov; }
-        T ar() const { return m_ar; }
-        T z_near() const { return m_z_near; }
-        T z_far() const { return m_z_far; }
+        constexpr angle<T> const& fov() const { return m_fov; }
+        constexpr T ar() const { return m_ar; }
+        constexpr T z_near() const { return m_z_near; }
+        constexpr T z_far() const { return m_z_far; }
     private:
         angle<T> m_fov;
         T m_ar;
@@ -80,62 +119,173 @@ namespace tinyla::geom {
     };
 
     template<typename T>
-    mat<4,T> perspective(frustum<T> const& frustum, handedness handedness, clip_volume clip_volume);
+    class view_box {
+    public:
+        constexpr view_box(T left, T right, T bottom, T top, T z_near, T z_far);
+        constexpr T left() const { return m_left; }
+        constexpr T right() const { return m_right; }
+        constexpr T bottom() const { return m_bottom; }
+        constexpr T top() const { return m_top; }
+        constexpr T z_near() const { return m_z_near; }
+        constexpr T z_far() const { return m_z_far; }
+    private:
+        T m_left;
+        T m_right;
+        T m_bottom;
+        T m_top;
+        T m_z_near;
+        T m_z_far;
+    };
+
+    /**
+    * A transformation matrix together with its inverse.
+    * Builders with a closed-form inverse return both so that callers can skip mat::inverted().
+    */
+    template<typename T>
+    struct transform_pair {
+        mat<4,T> matrix;
+        mat<4,T> inverse;
+    };
+
+    /**
+    * Translation, rotation and scale such that m = translation(t) * R * scaling(s).
+    */
+    template<typename T>
+    struct trs {
+        vec<3,T> translation;
+        mat<3,T> rotation;
+        vec<3,T> scale;
+    };
+
+    template<typename T>
+    constexpr mat<4,T> perspective(frustum<T> const& frustum, handedness handedness, clip_volume clip_volume);
+
+    template<typename T>
+    constexpr transform_pair<T> orthographic(view_box<T> const& box, handedness handedness, clip_volume clip_volume);
+
+    template<typename T>
+    constexpr transform_pair<T> look_at(vec<3, T> const& eye, vec<3, T> const& target, vec<3, T> const& up, handedness handedness);
+
+    template<typename T>
+    constexpr vec<4, T> project(mat<4, T> const& m, vec<4, T> const& v);
+
+    template<typename T>
+    constexpr mat<4, T> scaling(vec<3, T> const& s);
+
+    template<typename T>
+    constexpr mat<4, T> translation(vec<3, T> const& t);
+
+    template<typename T>
+    constexpr mat<4, T> rotation(angle<T> const& angle, vec<3, T> const& axis);
 
     template<typename T>
-    vec<4, T> project(mat<4, T> const& m, vec<4, T> const& v);
+    constexpr void pre_rotate(mat<4, T>& m, angle<T> const& angle, vec<3, T> const& axis);
 
     template<typename T>
-    mat<4, T> scaling(vec<3, T> const& s);
+    constexpr void post_rotate(mat<4, T>& m, const angle<T>& angle, const vec<3, T>& axis);
 
     template<typename T>
-    mat<4, T> translation(vec<3, T> const& t);
+    constexpr mat<4, T> rotation(cached_angle<T> const& angle, vec<3, T> const& axis);
 
     template<typename T>
-    mat<4, T> rotation(angle<T> const& angle, vec<3, T> const& axis);
+    constexpr void pre_rotate(mat<4, T>& m, cached_angle<T> const& angle, vec<3, T> const& axis);
 
     template<typename T>
-    void pre_rotate(mat<4, T>& m, angle<T> const& angle, vec<3, T> const& axis);
+    constexpr void post_rotate(mat<4, T>& m, cached_angle<T> const& angle, vec<3, T> const& axis);
 
     template<typename T>
-    void post_rotate(mat<4, T>& m, const angle<T>& angle, const vec<3, T>& axis);
+    constexpr void pre_translate(mat<4, T>& m, vec<3, T> const& t);
 
     template<typename T>
-    void pre_translate(mat<4, T>& m, vec<3, T> const& t);
+    constexpr void post_translate(mat<4, T>& m, const vec<3, T>& t);
 
     template<typename T>
-    void post_translate(mat<4, T>& m, const vec<3, T>& t);
+    constexpr void pre_scale(mat<4, T>& m, vec<3, T> const& s);
 
     template<typename T>
-    void pre_scale(mat<4, T>& m, vec<3, T> const& s);
+    constexpr void post_scale(mat<4, T>& m, vec<3, T> const& s);
 
     template<typename T>
-    void post_scale(mat<4, T>& m, vec<3, T> const& s);
+    constexpr trs<T> decompose(mat<4, T> const& m, decomposition decomposition = decomposition::orthogonal);
+
+    template<typename T>
+    constexpr mat<4, T> compose(trs<T> const& trs);
+
+    template<typename T>
+    void decompose(std::span<const mat<4, T>> ms,
+                   std::span<vec<3, std::type_identity_t<T>>> translations,
+                   std::span<mat<3, std::type_identity_t<T>>> rotations,
+                   std::span<vec<3, std::type_identity_t<T>>> scales,
+                   decomposition decomposition = decomposition::orthogonal);
+
+    template<typename T>
+    void compose(std::span<const vec<3, T>> translations,
+                 std::span<const mat<3, std::type_identity_t<T>>> rotations,
+                 std::span<const vec<3, std::type_identity_t<T>>> scales,
+                 std::span<mat<4, std::type_identity_t<T>>> out);
+
+    /**
+    * Model-view matrix relative to the camera at eye, narrowed to float.
+    * Both matrices are rebased to the eye in double precision, so that large world coordinates cancel out
+    * before the product is taken in float.
+    */
+    constexpr mat<4, float> camera_relative(mat<4, double> const& view, vec<3, double> const& eye, mat<4, double> const& model);
+
+    void camera_relative(mat<4, double> const& view, vec<3, double> const& eye,
+                         std::span<const mat<4, double>> models, std::span<mat<4, float>> out);
+
+    /**
+    * Positions relative to the camera at eye, narrowed to float.
+    */
+    void camera_relative(std::span<const vec<3, double>> points, vec<3, double> const& eye,
+                         std::span<vec<3, float>> out);
 
     namespace detail {
+        constexpr mat<4, double> rebased_view(mat<4, double> view, vec<3, double> const& eye);
+
+        constexpr mat<4, double> rebased_model(mat<4, double> model, vec<3, double> const& eye);
+
+        template<typename T>
+        constexpr mat<3, T> polar_rotation(mat<3, T> const& m);
+
+        template<typename T>
+        constexpr mat<4,T> perspective_rh_mo(frustum<T> const& frustum);
+
+        template<typename T>
+        constexpr mat<4,T> perspective_rh_zo(frustum<T> const& frustum);
+
+        template<typename T>
+        constexpr mat<4,T> orthographic_rh_mo(view_box<T> const& box);
+
+        template<typename T>
+        constexpr mat<4,T> orthographic_rh_zo(view_box<T> const& box);
+
+        template<typename T>
+        constexpr mat<4, T> rotation(T c, T s, vec<3, T> const& axis);
+
         template<typename T>
-        mat<4,T> perspective_rh_mo(frustum<T> const& frustum);
+        constexpr void pre_rotate(mat<4, T>& m, T c, T s, vec<3, T> const& axis);
 
         template<typename T>
-        mat<4,T> perspective_rh_zo(frustum<T> const& frustum);
+        constexpr void post_rotate(mat<4, T>& m, T c, T s, vec<3, T> const& axis);
 
         template<typename T>
-        void pre_rotate_x(tinyla::mat<4, T>& m, T c, T s);
+        constexpr void pre_rotate_x(tinyla::mat<4, T>& m, T c, T s);
 
         template<typename T>
-        void post_rotate_x(tinyla::mat<4, T>& m, T c, T s);
+        constexpr void post_rotate_x(tinyla::mat<4, T>& m, T c, T s);
 
         template<typename T>
-        void pre_rotate_y(tinyla::mat<4, T>& m, T c, T s);
+        constexpr void pre_rotate_y(tinyla::mat<4, T>& m, T c, T s);
 
         template<typename T>
-        void post_rotate_y(tinyla::mat<4, T>& m, T c, T s);
+        constexpr void post_rotate_y(tinyla::mat<4, T>& m, T c, T s);
 
         template<typename T>
-        void pre_rotate_z(tinyla::mat<4, T>& m, T c, T s);
+        constexpr void pre_rotate_z(tinyla::mat<4, T>& m, T c, T s);
 
         template<typename T>
-        void post_rotate_z(tinyla::mat<4, T>& m, T c, T s);
+        constexpr void post_rotate_z(tinyla::mat<4, T>& m, T c, T s);
     }
 }
 
@@ -18,7 +18,38 @@ namespace tinyla::geom {
     template<typename T>
     constexpr angle<T> angle<T>::from_degrees(T degrees)
     {
-        return angle{degrees * (std::numbers::pi_v<T> / 180)};
+        if constexpr (std::floating_point<T>) {
+            return angle{degrees * (std::numbers::pi_v<T> / 180)};
+        } else {
+            // pi / 180 alone would keep only a few significant bits in fixed point.
+            return angle{degrees * std::numbers::pi_v<T> / 180};
+        }
+    }
+
+    template<typename T>
+    constexpr cached_angle<T>::cached_angle(angle<T> const& a)
+        : m_radians{a.radians()}
+    {
+        auto const sc = tinyla::sincos(m_radians);
+        m_sin = sc.sin;
+        m_cos = sc.cos;
+    }
+
+    template<typename T>
+    void sincos(std::span<const angle<std::type_identity_t<T>>> angles, std::span<cached_angle<T>> out)
+    {
+        assert(angles.size() == out.size());
+        // Chunks small enough to stay in L1 between the passes.
+        constexpr std::size_t chunk = 256;
+        T radians[chunk];
+        T sines[chunk];
+        T cosines[chunk];
+        for (std::size_t first = 0; first < angles.size(); first += chunk) {
+            auto const n = std::min(chunk, angles.size() - first);
+            for (std::size_t i = 0; i < n; ++i) radians[i] = angles[first + i].radians();
+            tinyla::sincos<T>(std::span<const T>{radians, n}, std::span<T>{sines, n}, std::span<T>{cosines, n});
+            for (std::size_t i = 0; i < n; ++i) out[first + i] = cached_angle<T>{radians[i], sines[i], cosines[i]};
+        }
     }
 
     template<typename T>
@@ -30,7 +61,16 @@ namespace tinyla::geom {
     }
 
     template<typename T>
-    mat<4,T> perspective(frustum<T> const& frustum, handedness handedness, clip_volume clip_volume)
+    constexpr view_box<T>::view_box(T left, T right, T bottom, T top, T z_near, T z_far)
+        : m_left{left}, m_right{right}, m_bottom{bottom}, m_top{top}, m_z_near{z_near}, m_z_far{z_far}
+    {
+        assert(left != right);
+        assert(bottom != top);
+        assert(z_near != z_far);
+    }
+
+    template<typename T>
+    constexpr mat<4,T> perspective(frustum<T> const& frustum, handedness handedness, clip_volume clip_volume)
     {
         auto p = mat<4, T>{tinyla::mat_init::uninitialized};
         if (clip_volume == clip_volume::minus_one_to_one) {
@@ -46,7 +86,86 @@ namespace tinyla::geom {
     }
 
     template<typename T>
-    vec<4, T> project(mat<4, T> const& m, vec<4, T> const& v)
+    constexpr transform_pair<T> orthographic(view_box<T> const& box, handedness handedness, clip_volume clip_volume)
+    {
+        auto p = mat<4, T>{tinyla::mat_init::uninitialized};
+        if (clip_volume == clip_volume::minus_one_to_one) {
+            p = detail::orthographic_rh_mo(box);
+        } else {
+            p = detail::orthographic_rh_zo(box);
+        }
+        if (handedness == handedness::left) {
+            p[2, 2] = -p[2, 2];
+        }
+
+        /**
+         * Orthographic projection is a scaling followed by a translation, so is its inverse:
+         *
+         * | 1/m00  0      0      -m03/m00 |
+         * | 0      1/m11  0      -m13/m11 |
+         * | 0      0      1/m22  -m23/m22 |
+         * | 0      0      0       1       |
+         */
+        auto inv = mat<4, T>{tinyla::mat_init::identity};
+        for (std::size_t i = 0; i < 3; ++i) {
+            inv[i, i] = T{1} / p[i, i];
+            inv[i, 3] = -p[i, 3] * inv[i, i];
+        }
+        return {p, inv};
+    }
+
+    template<typename T>
+    constexpr transform_pair<T> look_at(vec<3, T> const& eye, vec<3, T> const& target, vec<3, T> const& up, handedness handedness)
+    {
+        /**
+         * s - side, u - up, f - backward (right-handed) or forward (left-handed) camera axis.
+         * The camera basis is orthonormal, so the inverse of its rotation is the transpose.
+         *
+         *          | sx  sy  sz  -s.eye |             | sx  ux  fx  eye.x |
+         *          | ux  uy  uz  -u.eye |             | sy  uy  fy  eye.y |
+         * view  =  | fx  fy  fz  -f.eye |   view^-1 = | sz  uz  fz  eye.z |
+         *          | 0   0   0    1     |             | 0   0   0   1     |
+         */
+        auto d = (target - eye).normalized();
+        auto s = vec<3, T>{vec_init::uninitialized};
+        auto f = vec<3, T>{vec_init::uninitialized};
+        if (handedness == handedness::right) {
+            s = cross(d, up).normalized();
+            f = -d;
+        } else {
+            s = cross(up, d).normalized();
+            f = d;
+        }
+        auto const u = cross(f, s);
+
+        auto view = mat<4, T>{mat_init::uninitialized};
+        auto inv = mat<4, T>{mat_init::uninitialized};
+        for (std::size_t i = 0; i < 3; ++i) {
+            view[0, i] = s[i];
+            view[1, i] = u[i];
+            view[2, i] = f[i];
+            view[3, i] = T{0};
+
+            inv[i, 0] = s[i];
+            inv[i, 1] = u[i];
+            inv[i, 2] = f[i];
+            inv[i, 3] = eye[i];
+        }
+        view[0, 3] = -dot(s, eye);
+        view[1, 3] = -dot(u, eye);
+        view[2, 3] = -dot(f, eye);
+        view[3, 3] = T{1};
+
+        inv[3, 0] = T{0};
+        inv[3, 1] = T{0};
+        inv[3, 2] = T{0};
+        inv[3, 3] = T{1};
+
+        return {view, inv};
+    }
+
+    template<typename T>
+    constexpr vec<4, T> project(mat<4, T> const& m, vec<4, T> const& v)
     {
         auto result =  m * v;
         if (result.w() != T{0}) {
@@ -58,7 +177,7 @@ namespace tinyla::geom {
     }
 
     template<typename T>
-    tinyla::mat<4, T> scaling(vec<3, T> const& s)
+    constexpr tinyla::mat<4, T> scaling(vec<3, T> const& s)
     {
         /**
          * | sx  0   0   0 |
@@ -75,7 +194,7 @@ namespace tinyla::geom {
     }
 
     template<typename T>
-    tinyla::mat<4, T> translation(vec<3, T> const& t)
+    constexpr tinyla::mat<4, T> translation(vec<3, T> const& t)
     {
         /**
          * | 1  0  0  tx |
@@ -92,19 +211,28 @@ namespace tinyla::geom {
 
 
     template<typename T>
-    tinyla::mat<4, T> rotation(angle<T> const& angle, tinyla::vec<3, T> const& axis)
+    constexpr tinyla::mat<4, T> rotation(angle<T> const& angle, tinyla::vec<3, T> const& axis)
     {
-        T const a = angle.radians();
-        T const c = std::cos(a);
-        T const s = std::sin(a);
+        auto const sc = tinyla::sincos(angle.radians());
+        return detail::rotation(sc.cos, sc.sin, axis);
+    }
+
+    template<typename T>
+    constexpr tinyla::mat<4, T> rotation(cached_angle<T> const& angle, tinyla::vec<3, T> const& axis)
+    {
+        return detail::rotation(angle.cos(), angle.sin(), axis);
+    }
 
+    template<typename T>
+    constexpr tinyla::mat<4, T> detail::rotation(T c, T s, tinyla::vec<3, T> const& axis)
+    {
         auto x = axis.x();
         auto y = axis.y();
         auto z = axis.z();
 
         T len = x * x + y * y + z * z;
         if (!tinyla::close(len, T{ 1 }) && !close_to_zero(len)) {
-            len = std::sqrt(len);
+            len = tinyla::sqrt(len);
             x = x / len;
             y = y / len;
             z = z / len;
@@ -137,7 +265,7 @@ namespace tinyla::geom {
     }
 
     template<typename T>
-    void pre_translate(mat<4, T>& m, vec<3, T> const& t)
+    constexpr void pre_translate(mat<4, T>& m, vec<3, T> const& t)
     {
         /**
          * | 1  0  0  tx |   | m00   m01   m02   m03 |   | m00 + m30*tx   m01 + m31*tx   m02 + m32*tx   m03 + m33*tx |
@@ -165,7 +293,7 @@ namespace tinyla::geom {
     }
 
     template<typename T>
-    void post_translate(mat<4, T>& m, const vec<3, T>& t)
+    constexpr void post_translate(mat<4, T>& m, const vec<3, T>& t)
     {
         /**
          * | m00   m01   m02   m03 |   | 1  0  0  tx |   | m00   m01   m02   m00*tx + m01*ty + m02*tz + m03 |
@@ -182,7 +310,7 @@ namespace tinyla::geom {
     }
 
     template<typename T>
-    void pre_scale(mat<4, T>& m, vec<3, T> const& s)
+    constexpr void pre_scale(mat<4, T>& m, vec<3, T> const& s)
     {
         /**
          * | sx  0   0   0 |   | m00   m01   m02   m03 |   | m00*sx   m01*sx   m02*sx   m03*sx |
@@ -211,7 +339,7 @@ namespace tinyla::geom {
     }
 
     template<typename T>
-    void post_scale(mat<4, T>& m, vec<3, T> const& s)
+    constexpr void post_scale(mat<4, T>& m, vec<3, T> const& s)
     {
         /**
          * | m00   m01   m02   m03 |   | sx  0   0   0 |   | m00*sx   m01*sy   m02*sz   m03 |
@@ -239,11 +367,21 @@ namespace tinyla::geom {
     }
 
     template<typename T>
-    void pre_rotate(mat<4, T>& m, angle<T> const& angle, vec<3, T> const& axis)
+    constexpr void pre_rotate(mat<4, T>& m, angle<T> const& angle, vec<3, T> const& axis)
+    {
+        auto const sc = tinyla::sincos(angle.radians());
+        detail::pre_rotate(m, sc.cos, sc.sin, axis);
+    }
+
+    template<typename T>
+    constexpr void pre_rotate(mat<4, T>& m, cached_angle<T> const& angle, vec<3, T> const& axis)
+    {
+        detail::pre_rotate(m, angle.cos(), angle.sin(), axis);
+    }
+
+    template<typename T>
+    constexpr void detail::pre_rotate(mat<4, T>& m, T c, T s, vec<3, T> const& axis)
     {
-        T const a = angle.radians();
-        T const c = std::cos(a);
-        T const s = std::sin(a);
 
         auto x = axis.x();
         auto y = axis.y();
@@ -252,29 +390,43 @@ namespace tinyla::geom {
         if (x == T{0}) {
             if (y == T{0}) {
                 if (z != T{0}) {
+                    TINYLA_COUNT(pre_rotate_z, T);
                     detail::pre_rotate_z(m, c, s);
                     return;
                 }
             }
             else if (z == T{0}) {
+                TINYLA_COUNT(pre_rotate_y, T);
                 detail::pre_rotate_y(m, c, s);
                 return;
             }
         }
         else if (y == T{0} && z == T{0}) {
+            TINYLA_COUNT(pre_rotate_x, T);
             detail::pre_rotate_x(m, c, s);
             return;
         }
 
-        m = rotation(angle, axis) * m;
+        TINYLA_COUNT(pre_rotate_axis, T);
+        m = detail::rotation(c, s, axis) * m;
+    }
+
+    template<typename T>
+    constexpr void post_rotate(mat<4, T>& m, const angle<T>& angle, const vec<3, T>& axis)
+    {
+        auto const sc = tinyla::sincos(angle.radians());
+        detail::post_rotate(m, sc.cos, sc.sin, axis);
+    }
+
+    template<typename T>
+    constexpr void post_rotate(mat<4, T>& m, cached_angle<T> const& angle, vec<3, T> const& axis)
+    {
+        detail::post_rotate(m, angle.cos(), angle.sin(), axis);
     }
 
     template<typename T>
-    void post_rotate(mat<4, T>& m, const angle<T>& angle, const vec<3, T>& axis)
+    constexpr void detail::post_rotate(mat<4, T>& m, T c, T s, vec<3, T> const& axis)
     {
-        const T a = angle.radians();
-        const T c = std::cos(a);
-        const T s = std::sin(a);
 
         auto x = axis.x();
         auto y = axis.y();
@@ -283,31 +435,197 @@ namespace tinyla::geom {
         if (x == T{0}) {
             if (y == T{0}) {
                 if (z != T{0}) {
+                    TINYLA_COUNT(post_rotate_z, T);
                     detail::post_rotate_z(m, c, s);
                     return;
                 }
             }
             else if (z == T{0}) {
+                TINYLA_COUNT(post_rotate_y, T);
                 detail::post_rotate_y(m, c, s);
                 return;
             }
         }
         else if (y == T{0} && z == T{0}) {
+            TINYLA_COUNT(post_rotate_x, T);
             detail::post_rotate_x(m, c, s);
             return;
         }
 
-        m *= rotation(angle, axis);
+        TINYLA_COUNT(post_rotate_axis, T);
+        m *= detail::rotation(c, s, axis);
+    }
+
+    template<typename T>
+    constexpr trs<T> decompose(mat<4, T> const& m, decomposition decomposition)
+    {
+        auto result = trs<T>{
+            vec<3, T>{m[0, 3], m[1, 3], m[2, 3]},
+            mat<3, T>{mat_init::uninitialized},
+            vec<3, T>{vec_init::uninitialized}
+        };
+
+        auto columns = std::array<vec<3, T>, 3>{
+            vec<3, T>{m[0, 0], m[1, 0], m[2, 0]},
+            vec<3, T>{m[0, 1], m[1, 1], m[2, 1]},
+            vec<3, T>{m[0, 2], m[1, 2], m[2, 2]}
+        };
+
+        // A reflection is folded into the scale along x, so that the rest is a proper rotation.
+        T const sign = dot(columns[0], cross(columns[1], columns[2])) < T{0} ? -T{1} : T{1};
+        columns[0] *= sign;
+
+        if (decomposition == decomposition::orthogonal) {
+            for (std::size_t j = 0; j < 3; ++j) {
+                T const len = columns[j].length();
+                result.scale[j] = len;
+                for (std::size_t i = 0; i < 3; ++i) {
+                    result.rotation[i, j] = len == T{0} ? (i == j ? T{1} : T{0}) : columns[j][i] / len;
+                }
+            }
+        } else {
+            auto a = mat<3, T>{mat_init::uninitialized};
+            for (std::size_t j = 0; j < 3; ++j) {
+                for (std::size_t i = 0; i < 3; ++i) a[i, j] = columns[j][i];
+            }
+            result.rotation = detail::polar_rotation(a);
+            // The diagonal of the stretch R^T * A; its off-diagonal shear is dropped.
+            for (std::size_t j = 0; j < 3; ++j) {
+                result.scale[j] = T{0};
+                for (std::size_t i = 0; i < 3; ++i) result.scale[j] += result.rotation[i, j] * a[i, j];
+            }
+        }
+        result.scale.x() *= sign;
+
+        return result;
+    }
+
+    template<typename T>
+    constexpr mat<4, T> compose(trs<T> const& trs)
+    {
+        /**
+         * | r00*sx  r01*sy  r02*sz  tx |
+         * | r10*sx  r11*sy  r12*sz  ty |
+         * | r20*sx  r21*sy  r22*sz  tz |
+         * | 0       0       0       1  |
+         */
+        auto m = mat<4, T>{mat_init::uninitialized};
+        for (std::size_t j = 0; j < 3; ++j) {
+            for (std::size_t i = 0; i < 3; ++i) m[i, j] = trs.rotation[i, j] * trs.scale[j];
+            m[3, j] = T{0};
+            m[j, 3] = trs.translation[j];
+        }
+        m[3, 3] = T{1};
+        return m;
+    }
+
+    template<typename T>
+    void decompose(std::span<const mat<4, T>> ms,
+                   std::span<vec<3, std::type_identity_t<T>>> translations,
+                   std::span<mat<3, std::type_identity_t<T>>> rotations,
+                   std::span<vec<3, std::type_identity_t<T>>> scales,
+                   decomposition decomposition)
+    {
+        assert(translations.size() == ms.size());
+        assert(rotations.size() == ms.size());
+        assert(scales.size() == ms.size());
+        for (std::size_t i = 0; i < ms.size(); ++i) {
+            auto const d = decompose(ms[i], decomposition);
+            translations[i] = d.translation;
+            rotations[i] = d.rotation;
+            scales[i] = d.scale;
+        }
+    }
+
+    template<typename T>
+    void compose(std::span<const vec<3, T>> translations,
+                 std::span<const mat<3, std::type_identity_t<T>>> rotations,
+                 std::span<const vec<3, std::type_identity_t<T>>> scales,
+                 std::span<mat<4, std::type_identity_t<T>>> out)
+    {
+        assert(rotations.size() == translations.size());
+        assert(scales.size() == translations.size());
+        assert(out.size() == translations.size());
+        for (std::size_t i = 0; i < translations.size(); ++i) {
+            out[i] = compose(trs<T>{translations[i], rotations[i], scales[i]});
+        }
+    }
+
+    constexpr mat<4, float> camera_relative(mat<4, double> const& view, vec<3, double> const& eye, mat<4, double> const& model)
+    {
+        return detail::rebased_view(view, eye).cast<float>() * detail::rebased_model(model, eye).cast<float>();
+    }
+
+    inline void camera_relative(mat<4, double> const& view, vec<3, double> const& eye,
+                                std::span<const mat<4, double>> models, std::span<mat<4, float>> out)
+    {
+        assert(models.size() == out.size());
+        for (std::size_t i = 0; i < models.size(); ++i) {
+            out[i] = detail::rebased_model(models[i], eye).cast<float>();
+        }
+        multiply(detail::rebased_view(view, eye).cast<float>(), std::span<const mat<4, float>>{out}, out);
+    }
+
+    inline void camera_relative(std::span<const vec<3, double>> points, vec<3, double> const& eye,
+                                std::span<vec<3, float>> out)
+    {
+        assert(points.size() == out.size());
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            out[i] = (points[i] - eye).cast<float>();
+        }
     }
 
     namespace detail {
+        constexpr mat<4, double> rebased_view(mat<4, double> view, vec<3, double> const& eye)
+        {
+            // view * translation(eye): moves the origin of the world to the eye.
+            post_translate(view, eye);
+            return view;
+        }
+
+        constexpr mat<4, double> rebased_model(mat<4, double> model, vec<3, double> const& eye)
+        {
+            // translation(-eye) * model: expresses the model relative to the eye.
+            pre_translate(model, vec<3, double>{-eye.x(), -eye.y(), -eye.z()});
+            return model;
+        }
+
         template<typename T>
-        mat<4,T> perspective_rh_mo(frustum<T> const& frustum)
+        constexpr mat<3, T> polar_rotation(mat<3, T> const& m)
         {
-            T const half_angle = frustum.fov().radians() / T{2};
-            T const sin = std::sin(half_angle);
-            assert(sin != T{0});
-            T const cot = std::cos(half_angle) / sin;
+            /**
+             * Higham's iteration R = (R + R^-T) / 2 converges quadratically to the orthogonal factor
+             * of the polar decomposition m = R * S. R^-T is the cofactor matrix divided by the determinant,
+             * and the columns of the cofactor matrix are cross products of the columns of R.
+             */
+            auto r = m;
+            for (int iteration = 0; iteration < 32; ++iteration) {
+                auto const c0 = vec<3, T>{r[0, 0], r[1, 0], r[2, 0]};
+                auto const c1 = vec<3, T>{r[0, 1], r[1, 1], r[2, 1]};
+                auto const c2 = vec<3, T>{r[0, 2], r[1, 2], r[2, 2]};
+                auto const cof = std::array{cross(c1, c2), cross(c2, c0), cross(c0, c1)};
+                T const det = dot(c0, cof[0]);
+                if (close_to_zero(det)) break;
+
+                T delta = T{0};
+                for (std::size_t j = 0; j < 3; ++j) {
+                    for (std::size_t i = 0; i < 3; ++i) {
+                        T const next = (r[i, j] + cof[j][i] / det) / T{2};
+                        delta = std::max(delta, tinyla::abs(next - r[i, j]));
+                        r[i, j] = next;
+                    }
+                }
+                if (delta <= T{4} * std::numeric_limits<T>::epsilon()) break;
+            }
+            return r;
+        }
+
+        template<typename T>
+        constexpr mat<4,T> perspective_rh_mo(frustum<T> const& frustum)
+        {
+            auto const half_angle = tinyla::sincos(frustum.fov().radians() / T{2});
+            assert(half_angle.sin != T{0});
+            T const cot = half_angle.cos / half_angle.sin;
             T const& z_far = frustum.z_far();
             T const& z_near = frustum.z_near();
             T const clip = z_far - z_near;
@@ -322,12 +640,11 @@ namespace tinyla::geom {
         }
 
         template<typename T>
-        mat<4,T> perspective_rh_zo(frustum<T> const& frustum)
+        constexpr mat<4,T> perspective_rh_zo(frustum<T> const& frustum)
         {
-            T const half_angle = frustum.fov().radians() / T{2};
-            T const sin = std::sin(half_angle);
-            assert(sin != T{0});
-            T const cot = std::cos(half_angle) / sin;
+            auto const half_angle = tinyla::sincos(frustum.fov().radians() / T{2});
+            assert(half_angle.sin != T{0});
+            T const cot = half_angle.cos / half_angle.sin;
             T const& z_far = frustum.z_far();
             T const& z_near = frustum.z_near();
             T const clip = z_far - z_near;
@@ -342,7 +659,41 @@ namespace tinyla::geom {
         }
 
         template<typename T>
-        void pre_rotate_x(tinyla::mat<4, T>& m, T c, T s)
+        constexpr mat<4,T> orthographic_rh_mo(view_box<T> const& box)
+        {
+            T const width = box.right() - box.left();
+            T const height = box.top() - box.bottom();
+            T const clip = box.z_far() - box.z_near();
+
+            auto p = mat<4, T>{mat_init::identity};
+            p[0, 0] = T{2} / width;
+            p[1, 1] = T{2} / height;
+            p[2, 2] = -T{2} / clip;
+            p[0, 3] = -(box.right() + box.left()) / width;
+            p[1, 3] = -(box.top() + box.bottom()) / height;
+            p[2, 3] = -(box.z_far() + box.z_near()) / clip;
+            return p;
+        }
+
+        template<typename T>
+        constexpr mat<4,T> orthographic_rh_zo(view_box<T> const& box)
+        {
+            T const width = box.right() - box.left();
+            T const height = box.top() - box.bottom();
+            T const clip = box.z_far() - box.z_near();
+
+            auto p = mat<4, T>{mat_init::identity};
+            p[0, 0] = T{2} / width;
+            p[1, 1] = T{2} / height;
+            p[2, 2] = -T{1} / clip;
+            p[0, 3] = -(box.right() + box.left()) / width;
+            p[1, 3] = -(box.top() + box.bottom()) / height;
+            p[2, 3] = -box.z_near() / clip;
+            return p;
+        }
+
+        template<typename T>
+        constexpr void pre_rotate_x(tinyla::mat<4, T>& m, T c, T s)
         {
             /**
              * | 1   0   0   0 |   | m00   m01   m02   m03 |   | m00           m01           m02           m03         |
@@ -358,7 +709,7 @@ namespace tinyla::geom {
         }
 
         template<typename T>
-        void post_rotate_x(tinyla::mat<4, T>& m, T c, T s)
+        constexpr void post_rotate_x(tinyla::mat<4, T>& m, T c, T s)
         {
             /**
              * | m00   m01   m02   m03 |   | 1   0   0   0 |   | m00    m01*c + m02*s    -m01*s + m02*c   m03 |
@@ -375,7 +726,7 @@ namespace tinyla::geom {
         }
 
         template<typename T>
-        void pre_rotate_y(tinyla::mat<4, T>& m, T c, T s)
+        constexpr void pre_rotate_y(tinyla::mat<4, T>& m, T c, T s)
         {
             /**
              * |  c   0   s   0 |   | m00   m01   m02   m03 |   | m00*c+m20*s   m01*c+m21*s   m02*c+m22*s   m03*c+m23*s |
@@ -391,7 +742,7 @@ namespace tinyla::geom {
         }
 
         template<typename T>
-        void post_rotate_y(tinyla::mat<4, T>& m, T c, T s)
+        constexpr void post_rotate_y(tinyla::mat<4, T>& m, T c, T s)
         {
             /**
              * | m00   m01   m02   m03 |   |  c   0   s   0 |   | m00*c - m02*s   m01   m00*s + m02*c   m03 |
@@ -407,7 +758,7 @@ namespace tinyla::geom {
         }
 
         template<typename T>
-        void pre_rotate_z(tinyla::mat<4, T>& m, T c, T s)
+        constexpr void pre_rotate_z(tinyla::mat<4, T>& m, T c, T s)
         {
             /**
              * | c   -s   0   0 |   | m00   m01   m02   m03 |   | m00*c-m10*s   m01*c-m11*s   m02*c-m12*s   m03*c-m13*s |
@@ -423,7 +774,7 @@ namespace tinyla::geom {
         }
 
         template<typename T>
-        void post_rotate_z(tinyla::mat<4, T>& m, T c, T s)
+        constexpr void post_rotate_z(tinyla::mat<4, T>& m, T c, T s)
         {
             /**
              * | m00   m01   m02   m03 |   | c   -s   0   0 |   | m00*c + m01*s   -m00*s - m01*c   m02   m03 |
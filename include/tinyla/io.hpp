@@ -0,0 +1,139 @@
+#ifndef TINYLA_IO_HPP
+#define TINYLA_IO_HPP
+
+#include <tinyla/mat.hpp>
+#include <tinyla/vec.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <span>
+#include <system_error>
+#include <type_traits>
+
+/**
+* Binary container for arrays of vec and mat, laid out so that a file can be memory mapped and used in place.
+*
+* The file starts with a 64-byte header followed by the data at data_offset, which is a multiple of alignment.
+* AoS data is the elements as they are in memory. SoA data is one array per scalar component
+* (in the order of data()), each starting at a multiple of alignment.
+* Numbers are stored in the byte order of the writer; readers with a different byte order reject the file.
+*/
+
+namespace tinyla::io
+{
+    enum class layout : std::uint8_t {
+        aos,
+        soa
+    };
+
+    enum class kind : std::uint8_t {
+        vec,
+        mat
+    };
+
+    enum class scalar_type : std::uint8_t {
+        int32,
+        float32,
+        float64
+    };
+
+    struct header {
+        std::array<char, 8> magic;
+        std::uint32_t version;
+        std::uint32_t byte_order;
+        io::kind kind;
+        std::uint8_t n;
+        io::scalar_type scalar_type;
+        io::layout layout;
+        std::uint32_t alignment;
+        std::uint64_t count;
+        std::uint64_t data_offset;
+        std::array<std::uint8_t, 24> reserved;
+    };
+    static_assert(sizeof(header) == 64);
+
+    constexpr auto magic = std::array<char, 8>{'t', 'i', 'n', 'y', 'l', 'a', '\0', '\0'};
+    constexpr std::uint32_t version = 1;
+    constexpr std::uint32_t byte_order_mark = 0x01020304;
+    constexpr std::uint32_t default_alignment = 64;
+
+    /**
+    * What an element type looks like on disk; defined for vec and mat of int, float and double.
+    */
+    template<typename E>
+    struct element_traits;
+
+    template<std::size_t N, typename T>
+    struct element_traits<vec<N,T>> {
+        using scalar = T;
+        static constexpr io::kind kind = io::kind::vec;
+        static constexpr std::size_t n = N;
+        static constexpr std::size_t components = N;
+    };
+
+    template<std::size_t N, typename T>
+    struct element_traits<mat<N,T>> {
+        using scalar = T;
+        static constexpr io::kind kind = io::kind::mat;
+        static constexpr std::size_t n = N;
+        static constexpr std::size_t components = N * N;
+    };
+
+    template<typename E>
+    concept storable = requires {
+        typename element_traits<E>::scalar;
+    } && std::is_trivially_copyable_v<E>
+      && sizeof(E) == element_traits<E>::components * sizeof(typename element_traits<E>::scalar);
+
+    template<typename T>
+    constexpr scalar_type scalar_type_of();
+
+    template<storable E>
+    std::error_code write(std::filesystem::path const& path, std::span<const E> elements,
+                          layout layout = layout::aos, std::uint32_t alignment = default_alignment);
+
+    /**
+    * Read-only memory mapping of a file written by write() for the same element type.
+    */
+    template<storable E>
+    class mapped_array {
+    public:
+        using scalar = typename element_traits<E>::scalar;
+
+        static std::expected<mapped_array, std::error_code> open(std::filesystem::path const& path);
+
+        mapped_array(mapped_array&& other) noexcept;
+        mapped_array& operator=(mapped_array&& other) noexcept;
+        mapped_array(mapped_array const&) = delete;
+        mapped_array& operator=(mapped_array const&) = delete;
+        ~mapped_array();
+
+        io::header const& header() const { return *static_cast<io::header const*>(m_address); }
+        std::size_t size() const { return header().count; }
+
+        // The elements of an AoS file.
+        std::span<const E> elements() const;
+
+        // Component i (index into data()) of every element of an SoA file.
+        std::span<const scalar> component(std::size_t i) const;
+    private:
+        mapped_array(void* address, std::size_t length) : m_address{address}, m_length{length} {}
+        // Unmaps the file, leaving an empty object.
+        void reset() noexcept;
+        void* m_address;
+        std::size_t m_length;
+    };
+
+    namespace detail {
+        constexpr std::uint64_t align_up(std::uint64_t offset, std::uint64_t alignment);
+
+        template<storable E>
+        std::error_code validate(io::header const& header, std::size_t file_size);
+    }
+}
+
+#include "io.inl"
+
+#endif // TINYLA_IO_HPP
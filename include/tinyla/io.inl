@@ -0,0 +1,216 @@
+#ifndef TINYLA_IO_INL
+#define TINYLA_IO_INL
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define TINYLA_HAS_MMAP
+#endif
+
+namespace tinyla::io
+{
+    template<typename T>
+    constexpr scalar_type scalar_type_of()
+    {
+        if constexpr (std::is_same_v<T, std::int32_t>) return scalar_type::int32;
+        else if constexpr (std::is_same_v<T, float>) return scalar_type::float32;
+        else if constexpr (std::is_same_v<T, double>) return scalar_type::float64;
+        else static_assert(false && sizeof(T), "unsupported scalar type");
+    }
+
+    template<storable E>
+    std::error_code write(std::filesystem::path const& path, std::span<const E> elements,
+                          layout layout, std::uint32_t alignment)
+    {
+        using traits = element_traits<E>;
+        using T = typename traits::scalar;
+        assert(alignment >= alignof(T) && (alignment & (alignment - 1)) == 0);
+
+        auto h = header{};
+        h.magic = magic;
+        h.version = version;
+        h.byte_order = byte_order_mark;
+        h.kind = traits::kind;
+        h.n = static_cast<std::uint8_t>(traits::n);
+        h.scalar_type = scalar_type_of<T>();
+        h.layout = layout;
+        h.alignment = alignment;
+        h.count = elements.size();
+        h.data_offset = detail::align_up(sizeof(header), alignment);
+
+        auto os = std::ofstream{path, std::ios::binary | std::ios::trunc};
+        if (!os) return std::make_error_code(std::errc::io_error);
+
+        auto const padding = std::vector<char>(alignment, '\0');
+        auto pad_to = [&](std::uint64_t offset) {
+            auto const position = static_cast<std::uint64_t>(os.tellp());
+            os.write(padding.data(), static_cast<std::streamsize>(offset - position));
+        };
+
+        os.write(reinterpret_cast<char const*>(&h), sizeof(h));
+        pad_to(h.data_offset);
+
+        if (layout == layout::aos) {
+            os.write(reinterpret_cast<char const*>(elements.data()), static_cast<std::streamsize>(elements.size_bytes()));
+        } else {
+            // Gather one component at a time through a bounded buffer.
+            constexpr std::size_t chunk = 4096;
+            auto buffer = std::vector<T>(std::min(chunk, elements.size()));
+            for (std::size_t c = 0; c < traits::components; ++c) {
+                pad_to(detail::align_up(static_cast<std::uint64_t>(os.tellp()), alignment));
+                for (std::size_t first = 0; first < elements.size(); first += chunk) {
+                    auto const last = std::min(first + chunk, elements.size());
+                    for (std::size_t i = first; i < last; ++i) buffer[i - first] = elements[i].data()[c];
+                    os.write(reinterpret_cast<char const*>(buffer.data()), static_cast<std::streamsize>((last - first) * sizeof(T)));
+                }
+            }
+        }
+
+        os.flush();
+        return os ? std::error_code{} : std::make_error_code(std::errc::io_error);
+    }
+
+    template<storable E>
+    std::expected<mapped_array<E>, std::error_code> mapped_array<E>::open(std::filesystem::path const& path)
+    {
+#ifdef TINYLA_HAS_MMAP
+        int const fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return std::unexpected{std::error_code{errno, std::system_category()}};
+
+        struct stat st{};
+        if (::fstat(fd, &st) != 0) {
+            auto const error = std::error_code{errno, std::system_category()};
+            ::close(fd);
+            return std::unexpected{error};
+        }
+        auto const length = static_cast<std::size_t>(st.st_size);
+        if (length < sizeof(io::header)) {
+            ::close(fd);
+            return std::unexpected{std::make_error_code(std::errc::invalid_argument)};
+        }
+
+        void* address = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+        auto const error = std::error_code{errno, std::system_category()};
+        ::close(fd);
+        if (address == MAP_FAILED) return std::unexpected{error};
+
+        auto result = mapped_array{address, length};
+        if (auto const invalid = detail::validate<E>(result.header(), length)) return std::unexpected{invalid};
+        return result;
+#else
+        (void) path;
+        return std::unexpected{std::make_error_code(std::errc::not_supported)};
+#endif
+    }
+
+    template<storable E>
+    mapped_array<E>::mapped_array(mapped_array&& other) noexcept
+        : m_address{std::exchange(other.m_address, nullptr)}, m_length{std::exchange(other.m_length, 0)}
+    {}
+
+    template<storable E>
+    mapped_array<E>& mapped_array<E>::operator=(mapped_array&& other) noexcept
+    {
+        if (this != &other) {
+            reset();
+            m_address = std::exchange(other.m_address, nullptr);
+            m_length = std::exchange(other.m_length, 0);
+        }
+        return *this;
+    }
+
+    template<storable E>
+    mapped_array<E>::~mapped_array()
+    {
+        reset();
+    }
+
+    template<storable E>
+    void mapped_array<E>::reset() noexcept
+    {
+#ifdef TINYLA_HAS_MMAP
+        if (m_address) ::munmap(m_address, m_length);
+#endif
+        m_address = nullptr;
+        m_length = 0;
+    }
+
+    template<storable E>
+    std::span<const E> mapped_array<E>::elements() const
+    {
+        assert(header().layout == layout::aos);
+        auto const* first = static_cast<char const*>(m_address) + header().data_offset;
+        return {reinterpret_cast<E const*>(first), size()};
+    }
+
+    template<storable E>
+    std::span<const typename mapped_array<E>::scalar> mapped_array<E>::component(std::size_t i) const
+    {
+        assert(header().layout == layout::soa);
+        assert(i < element_traits<E>::components);
+        std::uint64_t offset = header().data_offset;
+        for (std::size_t c = 0; c < i; ++c) {
+            offset = detail::align_up(offset + size() * sizeof(scalar), header().alignment);
+        }
+        auto const* first = static_cast<char const*>(m_address) + offset;
+        return {reinterpret_cast<scalar const*>(first), size()};
+    }
+
+    namespace detail {
+        constexpr std::uint64_t align_up(std::uint64_t offset, std::uint64_t alignment)
+        {
+            return (offset + alignment - 1) / alignment * alignment;
+        }
+
+        template<storable E>
+        std::error_code validate(io::header const& header, std::size_t file_size)
+        {
+            using traits = element_traits<E>;
+            using T = typename traits::scalar;
+
+            if (header.magic != magic) return std::make_error_code(std::errc::invalid_argument);
+            if (header.version != version || header.byte_order != byte_order_mark) {
+                return std::make_error_code(std::errc::not_supported);
+            }
+            if (header.kind != traits::kind || header.n != traits::n || header.scalar_type != scalar_type_of<T>()) {
+                return std::make_error_code(std::errc::invalid_argument);
+            }
+            if (header.alignment < alignof(T) || (header.alignment & (header.alignment - 1)) != 0 ||
+                header.data_offset % header.alignment != 0) {
+                return std::make_error_code(std::errc::invalid_argument);
+            }
+            if (header.data_offset < sizeof(io::header) || header.data_offset > file_size) {
+                return std::make_error_code(std::errc::invalid_argument);
+            }
+
+            // Bound count by the bytes actually present before multiplying, so a corrupt count cannot wrap around.
+            std::uint64_t const available = file_size - header.data_offset;
+            std::uint64_t end = header.data_offset;
+            if (header.layout == layout::aos) {
+                if (header.count > available / sizeof(E)) return std::make_error_code(std::errc::invalid_argument);
+                end += header.count * sizeof(E);
+            } else if (header.layout == layout::soa) {
+                if (header.count > available / (traits::components * sizeof(T))) {
+                    return std::make_error_code(std::errc::invalid_argument);
+                }
+                for (std::size_t c = 0; c < traits::components; ++c) {
+                    if (c > 0) end = align_up(end, header.alignment);
+                    end += header.count * sizeof(T);
+                }
+            } else {
+                return std::make_error_code(std::errc::invalid_argument);
+            }
+            return end <= file_size ? std::error_code{} : std::make_error_code(std::errc::invalid_argument);
+        }
+    }
+}
+
+#endif // TINYLA_IO_INL
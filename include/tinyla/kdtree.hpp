@@ -0,0 +1,107 @@
+#ifndef TINYLA_KDTREE_HPP
+#define TINYLA_KDTREE_HPP
+
+#include <tinyla/mat.hpp>
+#include <tinyla/parallel.hpp>
+#include <tinyla/vec.hpp>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+/**
+* Static k-d tree over a vec3 point cloud for k-nearest-neighbour and radius queries.
+*
+* The tree is implicit: node i has children 2i + 1 and 2i + 2, every split puts the first half (rounded up)
+* of its range in the left child, and all leaves lie on the same level, holding at most bucket_size points.
+* Only the split plane of each inner node is stored, next to the points reordered into leaf order.
+*/
+
+namespace tinyla
+{
+    template<std::floating_point T>
+    struct neighbor {
+        std::uint32_t index;
+        T distance_squared;
+    };
+
+    template<std::floating_point T>
+    class kdtree {
+    public:
+        using point = vec<3,T>;
+
+        static constexpr std::uint32_t npos = std::numeric_limits<std::uint32_t>::max();
+        static constexpr std::size_t default_bucket_size = 16;
+
+        /**
+        * Builds the tree over a copy of the points, splitting the nodes of each level in parallel.
+        */
+        explicit kdtree(std::span<const point> points, std::size_t bucket_size = default_bucket_size,
+                        parallel::options const& options = {});
+
+        std::size_t size() const noexcept { return m_points.size(); }
+
+        /**
+        * Fills result with the result.size() points nearest to query, closest first, and returns how many
+        * were found (fewer only if the tree has fewer points). Ties are broken by the smaller index.
+        */
+        std::size_t nearest(point const& query, std::span<neighbor<T>> result) const;
+
+        /**
+        * k nearest neighbours of every query, stored in results[i * k, (i + 1) * k); entries beyond the size
+        * of the tree are {npos, infinity}.
+        */
+        void nearest(std::span<const point> queries, std::size_t k, std::span<neighbor<T>> results,
+                     parallel::options const& options = {}) const;
+
+        /**
+        * Replaces the contents of result with all points within radius of query, in no particular order,
+        * and returns their number.
+        */
+        std::size_t within(point const& query, T radius, std::vector<neighbor<T>>& result) const;
+
+        // Points in leaf order and their indices in the input array.
+        std::span<const point> points() const noexcept { return m_points; }
+        std::span<const std::uint32_t> indices() const noexcept { return m_indices; }
+    private:
+        struct range {
+            std::uint32_t node;
+            std::uint32_t first;
+            std::uint32_t count;
+            T distance_squared;
+        };
+
+        template<typename Leaf>
+        void traverse(point const& query, T const& bound, Leaf&& leaf) const;
+
+        std::vector<point> m_points;
+        std::vector<std::uint32_t> m_indices;
+        std::vector<T> m_splits;
+        std::vector<std::uint8_t> m_axes;
+    };
+
+    namespace detail {
+        template<typename T>
+        constexpr bool closer(neighbor<T> const& a, neighbor<T> const& b)
+        {
+            return a.distance_squared < b.distance_squared
+                || (a.distance_squared == b.distance_squared && a.index < b.index);
+        }
+
+        // Leaves are scanned in chunks of this many points, whose distances fit in a local array.
+        inline constexpr std::size_t leaf_chunk_size = 64;
+
+        /**
+        * distances[i] = |points[i] - query|^2, in a branch-free pass that vectorises; the leaf scans select
+        * from it afterwards.
+        */
+        template<std::floating_point T>
+        void distances_squared(vec<3,T> const& query, std::span<const vec<3,T>> points, T* distances);
+    }
+}
+
+#include "kdtree.inl"
+
+#endif // TINYLA_KDTREE_HPP
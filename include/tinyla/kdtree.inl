@@ -0,0 +1,186 @@
+#ifndef TINYLA_KDTREE_INL
+#define TINYLA_KDTREE_INL
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+
+namespace tinyla
+{
+    template<std::floating_point T>
+    kdtree<T>::kdtree(std::span<const point> points, std::size_t bucket_size, parallel::options const& options)
+    {
+        assert(bucket_size > 0);
+        assert(points.size() < npos);
+
+        struct entry {
+            point p;
+            std::uint32_t index;
+        };
+        auto entries = std::vector<entry>{};
+        entries.reserve(points.size());
+        for (std::size_t i = 0; i < points.size(); ++i) entries.push_back({points[i], static_cast<std::uint32_t>(i)});
+
+        auto const leaves = std::max<std::size_t>(1, (points.size() + bucket_size - 1) / bucket_size);
+        std::size_t depth = 0;
+        while ((std::size_t{1} << depth) < leaves) ++depth;
+
+        auto const inner = (std::size_t{1} << depth) - 1;
+        m_splits.assign(inner, T{0});
+        m_axes.assign(inner, 0);
+
+        // Ranges of the nodes of the current level, split in place level by level.
+        auto level = std::vector<std::pair<std::uint32_t, std::uint32_t>>{{0, static_cast<std::uint32_t>(points.size())}};
+        for (std::size_t d = 0; d < depth; ++d) {
+            auto const begin = (std::size_t{1} << d) - 1;
+            parallel::for_each_block(level.size(), 1, [&](std::size_t, std::size_t first, std::size_t last) {
+                for (std::size_t j = first; j < last; ++j) {
+                    auto const [lo, count] = level[j];
+                    if (count < 2) {
+                        if (count == 1) m_splits[begin + j] = entries[lo].p[0];
+                        continue;
+                    }
+
+                    auto box_min = entries[lo].p;
+                    auto box_max = entries[lo].p;
+                    for (std::size_t i = lo + 1; i < lo + count; ++i) {
+                        for (std::size_t c = 0; c < 3; ++c) {
+                            box_min[c] = std::min(box_min[c], entries[i].p[c]);
+                            box_max[c] = std::max(box_max[c], entries[i].p[c]);
+                        }
+                    }
+                    std::size_t axis = 0;
+                    for (std::size_t c = 1; c < 3; ++c) {
+                        if (box_max[c] - box_min[c] > box_max[axis] - box_min[axis]) axis = c;
+                    }
+
+                    auto const mid = entries.begin() + lo + (count + 1) / 2;
+                    std::nth_element(entries.begin() + lo, mid, entries.begin() + lo + count,
+                        [axis](entry const& a, entry const& b) { return a.p[axis] < b.p[axis]; });
+                    m_splits[begin + j] = mid->p[axis];
+                    m_axes[begin + j] = static_cast<std::uint8_t>(axis);
+                }
+            }, options);
+
+            auto next = std::vector<std::pair<std::uint32_t, std::uint32_t>>{};
+            next.reserve(2 * level.size());
+            for (auto const& [lo, count] : level) {
+                next.emplace_back(lo, (count + 1) / 2);
+                next.emplace_back(lo + (count + 1) / 2, count / 2);
+            }
+            level.swap(next);
+        }
+
+        m_points.reserve(entries.size());
+        m_indices.reserve(entries.size());
+        for (auto const& e : entries) {
+            m_points.push_back(e.p);
+            m_indices.push_back(e.index);
+        }
+    }
+
+    template<std::floating_point T>
+    std::size_t kdtree<T>::nearest(point const& query, std::span<neighbor<T>> result) const
+    {
+        auto const k = result.size();
+        if (k == 0) return 0;
+
+        // Max-heap of the best candidates so far in result[0, found).
+        std::size_t found = 0;
+        auto bound = std::numeric_limits<T>::infinity();
+        traverse(query, bound, [&](std::size_t first, std::size_t last) {
+            std::array<T, detail::leaf_chunk_size> distances;
+            for (auto chunk = first; chunk < last; chunk += distances.size()) {
+                auto const n = std::min(distances.size(), last - chunk);
+                detail::distances_squared(query, std::span<const point>{m_points}.subspan(chunk, n), distances.data());
+                for (std::size_t j = 0; j < n; ++j) {
+                    auto const candidate = neighbor<T>{m_indices[chunk + j], distances[j]};
+                    if (found < k) {
+                        result[found++] = candidate;
+                        std::push_heap(result.begin(), result.begin() + found, detail::closer<T>);
+                    } else if (detail::closer(candidate, result[0])) {
+                        std::pop_heap(result.begin(), result.end(), detail::closer<T>);
+                        result[k - 1] = candidate;
+                        std::push_heap(result.begin(), result.end(), detail::closer<T>);
+                    }
+                    if (found == k) bound = result[0].distance_squared;
+                }
+            }
+        });
+        std::sort_heap(result.begin(), result.begin() + found, detail::closer<T>);
+        return found;
+    }
+
+    template<std::floating_point T>
+    void kdtree<T>::nearest(std::span<const point> queries, std::size_t k, std::span<neighbor<T>> results,
+                            parallel::options const& options) const
+    {
+        assert(results.size() == queries.size() * k);
+        constexpr std::size_t block_size = 256;
+        parallel::for_each_block(queries.size(), block_size, [&](std::size_t, std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; ++i) {
+                auto const out = results.subspan(i * k, k);
+                auto const found = nearest(queries[i], out);
+                std::fill(out.begin() + found, out.end(), neighbor<T>{npos, std::numeric_limits<T>::infinity()});
+            }
+        }, options);
+    }
+
+    template<std::floating_point T>
+    std::size_t kdtree<T>::within(point const& query, T radius, std::vector<neighbor<T>>& result) const
+    {
+        result.clear();
+        T const bound = radius * radius;
+        traverse(query, bound, [&](std::size_t first, std::size_t last) {
+            std::array<T, detail::leaf_chunk_size> distances;
+            for (auto chunk = first; chunk < last; chunk += distances.size()) {
+                auto const n = std::min(distances.size(), last - chunk);
+                detail::distances_squared(query, std::span<const point>{m_points}.subspan(chunk, n), distances.data());
+                for (std::size_t j = 0; j < n; ++j) {
+                    if (distances[j] <= bound) result.push_back({m_indices[chunk + j], distances[j]});
+                }
+            }
+        });
+        return result.size();
+    }
+
+    template<std::floating_point T>
+    template<typename Leaf>
+    void kdtree<T>::traverse(point const& query, T const& bound, Leaf&& leaf) const
+    {
+        // Each inner level pushes at most one far child, and the depth is below 32.
+        std::array<range, 64> stack;
+        std::size_t top = 0;
+        stack[top++] = {0, 0, static_cast<std::uint32_t>(m_points.size()), T{0}};
+
+        while (top > 0) {
+            auto const r = stack[--top];
+            if (r.distance_squared > bound) continue;
+
+            if (r.node >= m_splits.size()) {
+                leaf(r.first, r.first + r.count);
+                continue;
+            }
+
+            T const diff = query[m_axes[r.node]] - m_splits[r.node];
+            auto const left = range{2 * r.node + 1, r.first, (r.count + 1) / 2, r.distance_squared};
+            auto const right = range{2 * r.node + 2, r.first + (r.count + 1) / 2, r.count / 2, r.distance_squared};
+            auto near = diff < T{0} ? left : right;
+            auto far = diff < T{0} ? right : left;
+            far.distance_squared = std::max(r.distance_squared, diff * diff);
+            if (far.count > 0) stack[top++] = far;
+            if (near.count > 0) stack[top++] = near;
+        }
+    }
+
+    namespace detail {
+        template<std::floating_point T>
+        void distances_squared(vec<3,T> const& query, std::span<const vec<3,T>> points, T* distances)
+        {
+            // Through length_squared, so that the distances are those of (p - query).length_squared() to the bit.
+            for (std::size_t i = 0; i < points.size(); ++i) distances[i] = (points[i] - query).length_squared();
+        }
+    }
+}
+
+#endif // TINYLA_KDTREE_INL
@@ -3,7 +3,6 @@
 
 #include <tinyla/vec.hpp>
 #include <initializer_list>
-#include <iostream>
 
 namespace tinyla
 {
@@ -14,46 +13,57 @@ namespace tinyla
         diagonal
     };
 
-    template<std::size_t N, typename T>
-    requires(N >= 2)
-    class mat;
+    /**
+    * R x C matrix stored in column-major order. mat<N,T> is the square case.
+    */
+    template<std::size_t R, std::size_t C, typename T>
+    requires(R >= 2 && C >= 2)
+    class matrix;
 
     template<std::size_t N, typename T>
-    requires(N >= 2)
-    mat<N, T> operator*(const mat<N,T>& a, const mat<N,T>& b);
+    using mat = matrix<N,N,T>;
 
-    template<std::size_t N, typename T>
-    requires(N >= 2)
-    vec<N,T> operator*(const mat<N,T>& m, const vec<N,T>& v);
+    template<std::size_t R, std::size_t K, std::size_t C, typename T>
+    constexpr matrix<R,C,T> operator*(const matrix<R,K,T>& a, const matrix<K,C,T>& b);
 
-    template<std::size_t N, typename T>
-    requires(N >= 2)
-    class mat {
+    template<std::size_t R, std::size_t C, typename T>
+    constexpr vec<R,T> operator*(const matrix<R,C,T>& m, const vec<C,T>& v);
+
+    template<std::size_t R, std::size_t C, typename T>
+    requires(R >= 2 && C >= 2)
+    class matrix {
     public:
-        constexpr explicit mat(mat_init init, vec<N,T> v = vec<N,T>{vec_init::zero});
-        constexpr mat(std::initializer_list<T> values);
+        static constexpr std::size_t rows = R;
+        static constexpr std::size_t columns = C;
+
+        // mat_init::identity and mat_init::diagonal set the leading diagonal of min(R, C) elements.
+        constexpr explicit matrix(mat_init init, vec<std::min(R, C),T> v = vec<std::min(R, C),T>{vec_init::zero});
+        // Values are given row by row.
+        constexpr matrix(std::initializer_list<T> values);
 
         constexpr T& operator[](std::size_t row, std::size_t column);
         constexpr T operator[](std::size_t row, std::size_t column) const;
 
-        constexpr mat operator*=(const mat& other);
+        constexpr matrix operator*=(const matrix& other) requires (R == C);
 
         constexpr void set_to_zero();
         constexpr void set_to_identity();
-        constexpr void set_to_diagonal(vec<N,T> const& v);
+        constexpr void set_to_diagonal(vec<std::min(R, C),T> const& v);
+
+        constexpr T determinant() const requires (R == 4 && C == 4);
+        constexpr matrix inverted() const requires (R == 4 && C == 4);
 
-        constexpr T determinant() const requires (N == 4);
-        constexpr mat inverted() const requires (N == 4);
+        constexpr matrix<C,R,T> transposed() const noexcept;
 
         constexpr T* data() noexcept;
         constexpr const T* data() const noexcept;
 
-        constexpr bool close_to(const mat& other);
+        constexpr bool close_to(const matrix& other);
 
-        friend mat<N,T> operator* <>(const mat<N,T>& a, const mat<N,T>& b);
-        friend vec<N,T> operator* <>(const mat<N,T>& a, const vec<N,T>& b);
+        template<typename U>
+        constexpr matrix<R,C,U> cast() const noexcept;
     private:
-        T m[N][N];
+        T m[C][R];
     };
 
     using mat2i = mat<2,int>;
@@ -63,8 +73,56 @@ namespace tinyla
     using mat2f = mat<2,float>;
     using mat3f = mat<3,float>;
     using mat4f = mat<4,float>;
+
+    using mat2d = mat<2,double>;
+    using mat3d = mat<3,double>;
+    using mat4d = mat<4,double>;
+
+    // 2D affine transforms
+    using mat2x3f = matrix<2,3,float>;
+    using mat2x3d = matrix<2,3,double>;
+
+    // 3D affine transforms
+    using mat3x4f = matrix<3,4,float>;
+    using mat3x4d = matrix<3,4,double>;
+
+    using mat4x3f = matrix<4,3,float>;
+    using mat4x3d = matrix<4,3,double>;
+
+    namespace detail {
+        /**
+        * Writes the transpose of the 4x4 block src[i * src_stride + j] to dst[j * dst_stride + i],
+        * in registers for float and double where SSE2 is available.
+        */
+        template<typename T>
+        void transpose4(T const* src, std::size_t src_stride, T* dst, std::size_t dst_stride);
+    }
 }
 
 #include "mat.inl"
 
+/**
+* Instantiates mat<N, T> and its products with the given declaration, see TINYLA_INSTANTIATE_VEC.
+*/
+#define TINYLA_INSTANTIATE_MAT(declaration, N, T) \
+    declaration class tinyla::matrix<N, N, T>; \
+    declaration tinyla::matrix<N, N, T> tinyla::operator*( \
+        tinyla::matrix<N, N, T> const&, tinyla::matrix<N, N, T> const&); \
+    declaration tinyla::vec<N, T> tinyla::operator*(tinyla::matrix<N, N, T> const&, tinyla::vec<N, T> const&)
+
+/**
+* The common aliases mat2f..mat4f and mat2d..mat4d.
+*/
+#define TINYLA_INSTANTIATE_MATS(declaration) \
+    TINYLA_INSTANTIATE_MAT(declaration, 2, float); \
+    TINYLA_INSTANTIATE_MAT(declaration, 3, float); \
+    TINYLA_INSTANTIATE_MAT(declaration, 4, float); \
+    TINYLA_INSTANTIATE_MAT(declaration, 2, double); \
+    TINYLA_INSTANTIATE_MAT(declaration, 3, double); \
+    TINYLA_INSTANTIATE_MAT(declaration, 4, double)
+
+#ifdef TINYLA_EXTERN_TEMPLATES
+TINYLA_INSTANTIATE_MATS(extern template);
+#endif
+
 #endif // TINYLA_MAT_H
@@ -1,9 +1,14 @@
 #ifndef TINYLA_MAT_INL
 #define TINYLA_MAT_INL
 
-template<std::size_t N, typename T>
-requires(N >= 2)
-constexpr tinyla::mat<N,T>::mat(mat_init init, vec<N,T> v)
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define TINYLA_HAS_SIMD_TRANSPOSE
+#endif
+
+template<std::size_t R, std::size_t C, typename T>
+requires(R >= 2 && C >= 2)
+constexpr tinyla::matrix<R,C,T>::matrix(mat_init init, vec<std::min(R, C),T> v)
 {
     switch (init) {
         case mat_init::uninitialized:
@@ -20,71 +25,71 @@ constexpr tinyla::mat<N,T>::mat(mat_init init, vec<N,T> v)
     }
 }
 
-template<std::size_t N, typename T>
-requires(N >= 2)
-constexpr tinyla::mat<N,T>::mat(std::initializer_list<T> values)
+template<std::size_t R, std::size_t C, typename T>
+requires(R >= 2 && C >= 2)
+constexpr tinyla::matrix<R,C,T>::matrix(std::initializer_list<T> values)
 {
-    assert(values.size() == N*N);
+    assert(values.size() == R*C);
     auto it = values.begin();
-    for (std::size_t i = 0; i < N; ++i) {
-        for (std::size_t j = 0; j < N; ++j) {
+    for (std::size_t i = 0; i < R; ++i) {
+        for (std::size_t j = 0; j < C; ++j) {
             m[j][i] = *it++;
         }
     }
 }
 
-template<std::size_t N, typename T>
-requires(N >= 2)
-constexpr T& tinyla::mat<N,T>::operator[](std::size_t row, std::size_t column)
+template<std::size_t R, std::size_t C, typename T>
+requires(R >= 2 && C >= 2)
+constexpr T& tinyla::matrix<R,C,T>::operator[](std::size_t row, std::size_t column)
 {
     return m[column][row];
 }
 
-template<std::size_t N, typename T>
-requires(N >= 2)
-constexpr T tinyla::mat<N,T>::operator[](std::size_t row, std::size_t column) const
+template<std::size_t R, std::size_t C, typename T>
+requires(R >= 2 && C >= 2)
+constexpr T tinyla::matrix<R,C,T>::operator[](std::size_t row, std::size_t column) const
 {
     return m[column][row];
 }
 
-template<std::size_t N, typename T>
-requires(N >= 2)
-constexpr void tinyla::mat<N,T>::set_to_zero()
+template<std::size_t R, std::size_t C, typename T>
+requires(R >= 2 && C >= 2)
+constexpr void tinyla::matrix<R,C,T>::set_to_zero()
 {
-    for (std::size_t i = 0; i < N; ++i) {
-        std::fill(&m[i][0], &m[i][0] + N, T{0});
+    for (std::size_t i = 0; i < C; ++i) {
+        std::fill(&m[i][0], &m[i][0] + R, T{0});
     }
 }
 
-template<std::size_t N, typename T>
-requires(N >= 2)
-constexpr void tinyla::mat<N,T>::set_to_identity()
+template<std::size_t R, std::size_t C, typename T>
+requires(R >= 2 && C >= 2)
+constexpr void tinyla::matrix<R,C,T>::set_to_identity()
 {
-    auto i = tinyla::vec<N,T>{vec_init::uninitialized};
+    auto i = tinyla::vec<std::min(R, C),T>{vec_init::uninitialized};
     i.fill(T{1});
     set_to_diagonal(i);
 }
 
-template<std::size_t N, typename T>
-requires(N >= 2)
-constexpr void tinyla::mat<N,T>::set_to_diagonal(vec<N,T> const& v)
+template<std::size_t R, std::size_t C, typename T>
+requires(R >= 2 && C >= 2)
+constexpr void tinyla::matrix<R,C,T>::set_to_diagonal(vec<std::min(R, C),T> const& v)
 {
     set_to_zero();
-    for (size_t i = 0; i < N; ++i) {
+    for (size_t i = 0; i < std::min(R, C); ++i) {
         m[i][i] = v[i];
     }
 }
 
 // Calculate the determinant of a 2x2 sub-matrix.
 template<typename T>
-static inline T det2(const T m[4][4], int col0, int col1, int row0, int row1)
+static constexpr T det2(const T m[4][4], int col0, int col1, int row0, int row1)
 {
     return m[col0][row0] * m[col1][row1] - m[col0][row1] * m[col1][row0];
 }
 
 // Calculate the determinant of a 3x3 sub-matrix.
 template<typename T>
-static inline T det3(const T m[4][4],
+static constexpr T det3(const T m[4][4],
      int col0, int col1, int col2,
      int row0, int row1, int row2)
 {
@@ -95,7 +100,7 @@ static inline T det3(const T m[4][4],
 
 // Calculate the determinant of a 4x4 matrix.
 template<typename T>
-static inline T det4(const T m[4][4])
+static constexpr T det4(const T m[4][4])
 {
     T det;
     det  = m[0][0] * det3(m, 1, 2, 3, 1, 2, 3);
@@ -105,22 +110,24 @@ static inline T det4(const T m[4][4])
     return det;
 }
 
-template<std::size_t N, typename T>
-requires(N >= 2)
-constexpr T tinyla::mat<N,T>::determinant() const requires (N == 4)
+template<std::size_t R, std::size_t C, typename T>
+requires(R >= 2 && C >= 2)
+constexpr T tinyla::matrix<R,C,T>::determinant() const requires (R == 4 && C == 4)
 {
+    TINYLA_COUNT(determinant, T);
     return det4(m);
 }
 
-template<std::size_t N, typename T>
-requires(N >= 2)
-constexpr tinyla::mat<N, T> tinyla::mat<N,T>::inverted() const requires (N == 4)
+template<std::size_t R, std::size_t C, typename T>
+requires(R >= 2 && C >= 2)
+constexpr tinyla::matrix<R,C,T> tinyla::matrix<R,C,T>::inverted() const requires (R == 4 && C == 4)
 {
-    auto inv = mat<N,T>{mat_init::uninitialized};
+    TINYLA_COUNT(inverted, T);
+    auto inv = matrix<R,C,T>{mat_init::uninitialized};
 
     auto det = det4(m);
     if (close_to_zero(det)) {
-        return tinyla::mat<N,T>{mat_init::identity};
+        return tinyla::matrix<R,C,T>{mat_init::identity};
     }
 
     det = T{1} / det;
@@ -148,36 +155,55 @@ constexpr tinyla::mat<N, T> tinyla::mat<N,T>::inverted() const requires (N == 4)
     return inv;
 }
 
-template<std::size_t N, typename T>
-requires(N >= 2)
-constexpr T* tinyla::mat<N,T>::data() noexcept
+template<std::size_t R, std::size_t C, typename T>
+requires(R >= 2 && C >= 2)
+constexpr tinyla::matrix<C,R,T> tinyla::matrix<R,C,T>::transposed() const noexcept
+{
+    auto t = tinyla::matrix<C,R,T>{mat_init::uninitialized};
+    if constexpr (R == 4 && C == 4) {
+        if (!std::is_constant_evaluated()) {
+            detail::transpose4(data(), 4, t.data(), 4);
+            return t;
+        }
+    }
+    for (std::size_t i = 0; i < C; ++i) {
+        for (std::size_t j = 0; j < R; ++j) {
+            t[i, j] = m[i][j];
+        }
+    }
+    return t;
+}
+
+template<std::size_t R, std::size_t C, typename T>
+requires(R >= 2 && C >= 2)
+constexpr T* tinyla::matrix<R,C,T>::data() noexcept
 {
     return *m;
 }
 
-template<std::size_t N, typename T>
-requires(N >= 2)
-constexpr const T* tinyla::mat<N,T>::data() const noexcept
+template<std::size_t R, std::size_t C, typename T>
+requires(R >= 2 && C >= 2)
+constexpr const T* tinyla::matrix<R,C,T>::data() const noexcept
 {
     return *m;
 }
 
-template<std::size_t N, typename T>
-requires(N >= 2)
-constexpr tinyla::mat<N,T> tinyla::mat<N,T>::operator*=(const mat<N,T>& other)
+template<std::size_t R, std::size_t C, typename T>
+requires(R >= 2 && C >= 2)
+constexpr tinyla::matrix<R,C,T> tinyla::matrix<R,C,T>::operator*=(const matrix<R,C,T>& other) requires (R == C)
 {
     const auto o = other; // prevent aliasing when &o == this
     *this = *this * o;
     return *this;
 }
 
-template<std::size_t N, typename T>
-requires(N >= 2)
-constexpr bool tinyla::mat<N,T>::close_to(mat<N,T> const& other)
+template<std::size_t R, std::size_t C, typename T>
+requires(R >= 2 && C >= 2)
+constexpr bool tinyla::matrix<R,C,T>::close_to(matrix<R,C,T> const& other)
 {
     // A simple iterative algorithm but for column-major order.
-    for (size_t i = 0; i < N; ++i) {
-        for (size_t j = 0; j < N; ++j) {
+    for (size_t i = 0; i < C; ++i) {
+        for (size_t j = 0; j < R; ++j) {
             if (!close(m[i][j], other.m[i][j])) {
                 return false;
             }
@@ -186,34 +212,81 @@ constexpr bool tinyla::mat<N,T>::close_to(mat<N,T> const& other)
     return true;
 }
 
-template<std::size_t N, typename T>
-requires(N >= 2)
-tinyla::mat<N,T> tinyla::operator*(const mat<N,T>& a, const mat<N,T>& b)
+template<std::size_t R, std::size_t C, typename T>
+requires(R >= 2 && C >= 2)
+template<typename U>
+constexpr tinyla::matrix<R,C,U> tinyla::matrix<R,C,T>::cast() const noexcept
+{
+    auto result = tinyla::matrix<R,C,U>{mat_init::uninitialized};
+    std::transform(data(), data() + R*C, result.data(), [](T c) { return static_cast<U>(c); });
+    return result;
+}
+
+template<std::size_t R, std::size_t K, std::size_t C, typename T>
+constexpr tinyla::matrix<R,C,T> tinyla::operator*(const matrix<R,K,T>& a, const matrix<K,C,T>& b)
 {
-    auto c = tinyla::mat<N,T>{mat_init::uninitialized};
-    for (size_t i = 0; i < N; ++i) {
-        for (size_t j = 0; j < N; ++j) {
-            c.m[i][j] = T{0};
-            for (size_t k = 0; k < N; ++k) {
-                c.m[i][j] += a.m[k][j] * b.m[i][k];
+    TINYLA_COUNT(mat_mul_mat, T);
+    auto c = tinyla::matrix<R,C,T>{mat_init::uninitialized};
+    for (size_t i = 0; i < C; ++i) {
+        for (size_t j = 0; j < R; ++j) {
+            T s = T{0};
+            for (size_t k = 0; k < K; ++k) {
+                s += a[j, k] * b[k, i];
             }
+            c[j, i] = s;
         }
     }
     return c;
 }
 
-template<std::size_t N, typename T>
-requires(N >= 2)
-tinyla::vec<N,T> tinyla::operator*(const mat<N,T>& m, const vec<N,T>& v)
+template<std::size_t R, std::size_t C, typename T>
+constexpr tinyla::vec<R,T> tinyla::operator*(const matrix<R,C,T>& m, const vec<C,T>& v)
 {
-    auto mv = tinyla::vec<N,T>{vec_init::uninitialized};
-    for (size_t i = 0; i < N; ++i) {
-        mv.v[i] = T{0};
-        for (size_t j = 0; j < N; ++j) {
-            mv.v[i] += m.m[j][i] * v.v[j];
+    TINYLA_COUNT(mat_mul_vec, T);
+    auto mv = tinyla::vec<R,T>{vec_init::uninitialized};
+    for (size_t i = 0; i < R; ++i) {
+        T s = T{0};
+        for (size_t j = 0; j < C; ++j) {
+            s += m[i, j] * v[j];
         }
+        mv[i] = s;
     }
     return mv;
 }
 
+template<typename T>
+void tinyla::detail::transpose4(T const* src, std::size_t src_stride, T* dst, std::size_t dst_stride)
+{
+#ifdef TINYLA_HAS_SIMD_TRANSPOSE
+    if constexpr (std::is_same_v<T, float>) {
+        __m128 r0 = _mm_loadu_ps(src);
+        __m128 r1 = _mm_loadu_ps(src + src_stride);
+        __m128 r2 = _mm_loadu_ps(src + 2 * src_stride);
+        __m128 r3 = _mm_loadu_ps(src + 3 * src_stride);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _mm_storeu_ps(dst, r0);
+        _mm_storeu_ps(dst + dst_stride, r1);
+        _mm_storeu_ps(dst + 2 * dst_stride, r2);
+        _mm_storeu_ps(dst + 3 * dst_stride, r3);
+        return;
+    } else if constexpr (std::is_same_v<T, double>) {
+        // Four 2x2 blocks, each transposed by an unpack pair and moved across the diagonal.
+        for (std::size_t bi = 0; bi < 4; bi += 2) {
+            for (std::size_t bj = 0; bj < 4; bj += 2) {
+                __m128d const a = _mm_loadu_pd(src + bi * src_stride + bj);
+                __m128d const b = _mm_loadu_pd(src + (bi + 1) * src_stride + bj);
+                _mm_storeu_pd(dst + bj * dst_stride + bi, _mm_unpacklo_pd(a, b));
+                _mm_storeu_pd(dst + (bj + 1) * dst_stride + bi, _mm_unpackhi_pd(a, b));
+            }
+        }
+        return;
+    }
+#endif
+    for (std::size_t i = 0; i < 4; ++i) {
+        for (std::size_t j = 0; j < 4; ++j) {
+            dst[j * dst_stride + i] = src[i * src_stride + j];
+        }
+    }
+}
+
 #endif // TINYLA_MAT_INL
@@ -0,0 +1,141 @@
+#ifndef TINYLA_MATX_HPP
+#define TINYLA_MATX_HPP
+
+#include <tinyla/mat.hpp>
+#include <tinyla/parallel.hpp>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+/**
+* Heap-allocated matrices of run-time size for the workloads mat<N,T> is too small for
+* (least squares, feature transforms), multiplied by cache-blocked, packed and multithreaded kernels.
+*
+* Storage is column-major like mat<N,T>, so both can be viewed through the same matx_view.
+*/
+
+namespace tinyla
+{
+    /**
+    * Non-owning column-major view: element (row, column) is at data[column * stride + row].
+    * T may be const for read-only views.
+    */
+    template<typename T>
+    struct matx_view {
+        T* data;
+        std::size_t rows;
+        std::size_t columns;
+        std::size_t stride;
+
+        constexpr T& operator[](std::size_t row, std::size_t column) const { return data[column * stride + row]; }
+
+        constexpr operator matx_view<const T>() const requires(!std::is_const_v<T>)
+        {
+            return {data, rows, columns, stride};
+        }
+
+        // Rows [row, row + rows) and columns [column, column + columns).
+        constexpr matx_view block(std::size_t row, std::size_t column, std::size_t rows, std::size_t columns) const;
+    };
+
+    template<std::size_t R, std::size_t C, typename T>
+    constexpr matx_view<T> view(matrix<R,C,T>& m) { return {m.data(), R, C, R}; }
+
+    template<std::size_t R, std::size_t C, typename T>
+    constexpr matx_view<const T> view(matrix<R,C,T> const& m) { return {m.data(), R, C, R}; }
+
+    template<typename T>
+    class matx {
+    public:
+        /**
+        * mat_init::diagonal is not supported; use identity and scale instead.
+        */
+        matx(std::size_t rows, std::size_t columns, mat_init init = mat_init::zero);
+
+        template<std::size_t N>
+        explicit matx(mat<N,T> const& m);
+
+        std::size_t rows() const noexcept { return m_rows; }
+        std::size_t columns() const noexcept { return m_columns; }
+
+        T& operator[](std::size_t row, std::size_t column) { return m_data[column * m_rows + row]; }
+        T operator[](std::size_t row, std::size_t column) const { return m_data[column * m_rows + row]; }
+
+        T* data() noexcept { return m_data.data(); }
+        const T* data() const noexcept { return m_data.data(); }
+
+        matx_view<T> view() noexcept { return {m_data.data(), m_rows, m_columns, m_rows}; }
+        matx_view<const T> view() const noexcept { return {m_data.data(), m_rows, m_columns, m_rows}; }
+
+        // Copy of an N x N matrix.
+        template<std::size_t N>
+        mat<N,T> to_mat() const;
+    private:
+        std::size_t m_rows;
+        std::size_t m_columns;
+        std::vector<T> m_data;
+    };
+
+    /**
+    * c = alpha * a * b + beta * c
+    * c must not overlap a or b. With beta == 0, c is overwritten without being read.
+    */
+    template<typename T>
+    void gemm(T alpha, matx_view<const std::type_identity_t<T>> a, matx_view<const std::type_identity_t<T>> b,
+              T beta, matx_view<std::type_identity_t<T>> c, parallel::options const& options = {});
+
+    /**
+    * y = alpha * a * x + beta * y
+    */
+    template<typename T>
+    void gemv(T alpha, matx_view<const std::type_identity_t<T>> a, std::span<const std::type_identity_t<T>> x,
+              T beta, std::span<std::type_identity_t<T>> y, parallel::options const& options = {});
+
+    template<typename T>
+    matx<T> operator*(matx<T> const& a, matx<T> const& b);
+
+    namespace detail {
+        // Width in bytes of the widest vector registers of the target.
+#if defined(__AVX512F__)
+        constexpr std::size_t simd_bytes = 64;
+#elif defined(__AVX__)
+        constexpr std::size_t simd_bytes = 32;
+#else
+        constexpr std::size_t simd_bytes = 16;
+#endif
+
+        /**
+        * Blocking parameters: a kc x nc panel of b is packed once and shared by all threads, each thread
+        * packs mc x kc blocks of a, and the micro-kernel keeps an mr x nr block of c in registers, as nr
+        * columns of two vectors each.
+        */
+        template<typename T>
+        struct gemm_blocking {
+            static constexpr std::size_t mr = 2 * simd_bytes / sizeof(T);
+            static constexpr std::size_t nr = 4;
+            static constexpr std::size_t mc = 128;
+            static constexpr std::size_t kc = 256;
+            static constexpr std::size_t nc = 2048;
+        };
+
+        constexpr std::size_t gemv_block_rows = 512;
+
+        template<typename T>
+        void pack_a(matx_view<const T> a, T* packed);
+
+        template<typename T>
+        void pack_b(matx_view<const T> b, T* packed);
+
+        // One vector register of T, as seen by the micro-kernel.
+        template<typename T>
+        struct gemm_vector;
+
+        template<typename T>
+        void gemm_micro_kernel(std::size_t kc, T alpha, T const* a, T const* b, matx_view<T> c);
+    }
+}
+
+#include "matx.inl"
+
+#endif // TINYLA_MATX_HPP
@@ -0,0 +1,294 @@
+#ifndef TINYLA_MATX_INL
+#define TINYLA_MATX_INL
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <utility>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+namespace tinyla
+{
+    template<typename T>
+    constexpr matx_view<T> matx_view<T>::block(std::size_t row, std::size_t column,
+                                               std::size_t rows, std::size_t columns) const
+    {
+        assert(row + rows <= this->rows && column + columns <= this->columns);
+        return {data + column * stride + row, rows, columns, stride};
+    }
+
+    template<typename T>
+    matx<T>::matx(std::size_t rows, std::size_t columns, mat_init init)
+        : m_rows{rows}
+        , m_columns{columns}
+        , m_data(rows * columns)
+    {
+        assert(init != mat_init::diagonal);
+        if (init == mat_init::identity) {
+            for (std::size_t i = 0; i < std::min(rows, columns); ++i) (*this)[i, i] = T{1};
+        }
+    }
+
+    template<typename T>
+    template<std::size_t N>
+    matx<T>::matx(mat<N,T> const& m)
+        : m_rows{N}
+        , m_columns{N}
+        , m_data(m.data(), m.data() + N * N)
+    {
+    }
+
+    template<typename T>
+    template<std::size_t N>
+    mat<N,T> matx<T>::to_mat() const
+    {
+        assert(m_rows == N && m_columns == N);
+        auto result = mat<N,T>{mat_init::uninitialized};
+        std::copy(m_data.begin(), m_data.end(), result.data());
+        return result;
+    }
+
+    template<typename T>
+    void gemm(T alpha, matx_view<const std::type_identity_t<T>> a, matx_view<const std::type_identity_t<T>> b,
+              T beta, matx_view<std::type_identity_t<T>> c, parallel::options const& options)
+    {
+        using blocking = detail::gemm_blocking<T>;
+        assert(a.rows == c.rows && b.columns == c.columns && a.columns == b.rows);
+
+        if (beta != T{1}) {
+            for (std::size_t j = 0; j < c.columns; ++j) {
+                for (std::size_t i = 0; i < c.rows; ++i) c[i, j] = beta == T{0} ? T{0} : beta * c[i, j];
+            }
+        }
+        if (alpha == T{0} || a.columns == 0) return;
+
+        auto packed_b = std::vector<T>{};
+        for (std::size_t jc = 0; jc < c.columns; jc += blocking::nc) {
+            auto const nc = std::min(blocking::nc, c.columns - jc);
+            for (std::size_t pc = 0; pc < a.columns; pc += blocking::kc) {
+                auto const kc = std::min(blocking::kc, a.columns - pc);
+
+                packed_b.resize(kc * ((nc + blocking::nr - 1) / blocking::nr) * blocking::nr);
+                detail::pack_b(b.block(pc, jc, kc, nc), packed_b.data());
+
+                // Row blocks of c are independent; each is always computed in the same order.
+                parallel::for_each_block(c.rows, blocking::mc, [&](std::size_t, std::size_t ic, std::size_t last) {
+                    auto const mc = last - ic;
+                    auto packed_a = std::vector<T>(kc * ((mc + blocking::mr - 1) / blocking::mr) * blocking::mr);
+                    detail::pack_a(a.block(ic, pc, mc, kc), packed_a.data());
+
+                    for (std::size_t jr = 0; jr < nc; jr += blocking::nr) {
+                        auto const nr = std::min(blocking::nr, nc - jr);
+                        for (std::size_t ir = 0; ir < mc; ir += blocking::mr) {
+                            auto const mr = std::min(blocking::mr, mc - ir);
+                            detail::gemm_micro_kernel(kc, alpha, packed_a.data() + ir * kc, packed_b.data() + jr * kc,
+                                                      c.block(ic + ir, jc + jr, mr, nr));
+                        }
+                    }
+                }, options);
+            }
+        }
+    }
+
+    template<typename T>
+    void gemv(T alpha, matx_view<const std::type_identity_t<T>> a, std::span<const std::type_identity_t<T>> x,
+              T beta, std::span<std::type_identity_t<T>> y, parallel::options const& options)
+    {
+        assert(a.columns == x.size() && a.rows == y.size());
+
+        // Column-oriented within a block of rows, so that the inner loop runs down contiguous columns.
+        parallel::for_each_block(a.rows, detail::gemv_block_rows, [&](std::size_t, std::size_t first, std::size_t last) {
+            T acc[detail::gemv_block_rows];
+            std::fill(acc, acc + (last - first), T{0});
+            for (std::size_t j = 0; j < a.columns; ++j) {
+                T const xj = x[j];
+                T const* column = &a[first, j];
+                for (std::size_t i = 0; i < last - first; ++i) acc[i] += column[i] * xj;
+            }
+            for (std::size_t i = first; i < last; ++i) {
+                y[i] = alpha * acc[i - first] + (beta == T{0} ? T{0} : beta * y[i]);
+            }
+        }, options);
+    }
+
+    template<typename T>
+    matx<T> operator*(matx<T> const& a, matx<T> const& b)
+    {
+        // c starts zeroed, so accumulating into it with beta = 1 skips the scaling pass of gemm.
+        auto c = matx<T>{a.rows(), b.columns()};
+        gemm(T{1}, a.view(), b.view(), T{1}, c.view());
+        return c;
+    }
+
+    namespace detail {
+        template<typename T>
+        void pack_a(matx_view<const T> a, T* packed)
+        {
+            // Panels of mr rows, stored k by k and zero-padded to mr.
+            constexpr auto mr = gemm_blocking<T>::mr;
+            for (std::size_t i0 = 0; i0 < a.rows; i0 += mr) {
+                auto const rows = std::min(mr, a.rows - i0);
+                for (std::size_t k = 0; k < a.columns; ++k) {
+                    T const* column = &a[i0, k];
+                    for (std::size_t i = 0; i < rows; ++i) *packed++ = column[i];
+                    for (std::size_t i = rows; i < mr; ++i) *packed++ = T{0};
+                }
+            }
+        }
+
+        template<typename T>
+        void pack_b(matx_view<const T> b, T* packed)
+        {
+            // Panels of nr columns, stored k by k and zero-padded to nr.
+            constexpr auto nr = gemm_blocking<T>::nr;
+            for (std::size_t j0 = 0; j0 < b.columns; j0 += nr) {
+                auto const columns = std::min(nr, b.columns - j0);
+                for (std::size_t k = 0; k < b.rows; ++k) {
+                    for (std::size_t j = 0; j < columns; ++j) *packed++ = b[k, j0 + j];
+                    for (std::size_t j = columns; j < nr; ++j) *packed++ = T{0};
+                }
+            }
+        }
+
+        // Portable fallback, which the compiler maps to vector registers where it can.
+        template<typename T>
+        struct gemm_vector {
+            static constexpr std::size_t width = simd_bytes / sizeof(T);
+            using type = std::array<T, width>;
+
+            static type load(T const* p)
+            {
+                type r;
+                std::copy(p, p + width, r.begin());
+                return r;
+            }
+
+            static type broadcast(T x)
+            {
+                type r;
+                r.fill(x);
+                return r;
+            }
+
+            static type multiply_add(type const& a, type const& b, type c)
+            {
+                for (std::size_t i = 0; i < width; ++i) c[i] += a[i] * b[i];
+                return c;
+            }
+
+            static void store(T* p, type const& x) { std::copy(x.begin(), x.end(), p); }
+        };
+
+#if defined(__AVX512F__)
+        template<>
+        struct gemm_vector<float> {
+            static constexpr std::size_t width = 16;
+            using type = __m512;
+            static type load(float const* p) { return _mm512_loadu_ps(p); }
+            static type broadcast(float x) { return _mm512_set1_ps(x); }
+            static type multiply_add(type a, type b, type c) { return _mm512_fmadd_ps(a, b, c); }
+            static void store(float* p, type x) { _mm512_storeu_ps(p, x); }
+        };
+
+        template<>
+        struct gemm_vector<double> {
+            static constexpr std::size_t width = 8;
+            using type = __m512d;
+            static type load(double const* p) { return _mm512_loadu_pd(p); }
+            static type broadcast(double x) { return _mm512_set1_pd(x); }
+            static type multiply_add(type a, type b, type c) { return _mm512_fmadd_pd(a, b, c); }
+            static void store(double* p, type x) { _mm512_storeu_pd(p, x); }
+        };
+#elif defined(__AVX__)
+        template<>
+        struct gemm_vector<float> {
+            static constexpr std::size_t width = 8;
+            using type = __m256;
+            static type load(float const* p) { return _mm256_loadu_ps(p); }
+            static type broadcast(float x) { return _mm256_set1_ps(x); }
+#ifdef __FMA__
+            static type multiply_add(type a, type b, type c) { return _mm256_fmadd_ps(a, b, c); }
+#else
+            static type multiply_add(type a, type b, type c) { return _mm256_add_ps(_mm256_mul_ps(a, b), c); }
+#endif
+            static void store(float* p, type x) { _mm256_storeu_ps(p, x); }
+        };
+
+        template<>
+        struct gemm_vector<double> {
+            static constexpr std::size_t width = 4;
+            using type = __m256d;
+            static type load(double const* p) { return _mm256_loadu_pd(p); }
+            static type broadcast(double x) { return _mm256_set1_pd(x); }
+#ifdef __FMA__
+            static type multiply_add(type a, type b, type c) { return _mm256_fmadd_pd(a, b, c); }
+#else
+            static type multiply_add(type a, type b, type c) { return _mm256_add_pd(_mm256_mul_pd(a, b), c); }
+#endif
+            static void store(double* p, type x) { _mm256_storeu_pd(p, x); }
+        };
+#elif defined(__SSE2__) || defined(_M_X64)
+        template<>
+        struct gemm_vector<float> {
+            static constexpr std::size_t width = 4;
+            using type = __m128;
+            static type load(float const* p) { return _mm_loadu_ps(p); }
+            static type broadcast(float x) { return _mm_set1_ps(x); }
+            static type multiply_add(type a, type b, type c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+            static void store(float* p, type x) { _mm_storeu_ps(p, x); }
+        };
+
+        template<>
+        struct gemm_vector<double> {
+            static constexpr std::size_t width = 2;
+            using type = __m128d;
+            static type load(double const* p) { return _mm_loadu_pd(p); }
+            static type broadcast(double x) { return _mm_set1_pd(x); }
+            static type multiply_add(type a, type b, type c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+            static void store(double* p, type x) { _mm_storeu_pd(p, x); }
+        };
+#endif
+
+        template<typename T>
+        void gemm_micro_kernel(std::size_t kc, T alpha, T const* a, T const* b, matx_view<T> c)
+        {
+            using vector = gemm_vector<T>;
+            constexpr auto mr = gemm_blocking<T>::mr;
+            constexpr auto nr = gemm_blocking<T>::nr;
+            constexpr auto height = mr / vector::width;
+            static_assert(height * vector::width == mr);
+
+            // One accumulator per vector of the tile, with k outermost. The columns are unrolled by the fold
+            // so that every accumulator has a constant index and stays in a register.
+            typename vector::type acc[nr][height];
+            for (std::size_t j = 0; j < nr; ++j) {
+                for (std::size_t h = 0; h < height; ++h) acc[j][h] = vector::broadcast(T{0});
+            }
+            [&]<std::size_t... j>(std::index_sequence<j...>) {
+                for (std::size_t k = 0; k < kc; ++k) {
+                    typename vector::type ak[height];
+                    for (std::size_t h = 0; h < height; ++h) ak[h] = vector::load(a + k * mr + h * vector::width);
+                    ([&] {
+                        auto const bkj = vector::broadcast(b[k * nr + j]);
+                        for (std::size_t h = 0; h < height; ++h) acc[j][h] = vector::multiply_add(ak[h], bkj, acc[j][h]);
+                    }(), ...);
+                }
+            }(std::make_index_sequence<nr>{});
+
+            T tile[nr][mr];
+            for (std::size_t j = 0; j < nr; ++j) {
+                for (std::size_t h = 0; h < height; ++h) vector::store(tile[j] + h * vector::width, acc[j][h]);
+            }
+            for (std::size_t j = 0; j < c.columns; ++j) {
+                for (std::size_t i = 0; i < c.rows; ++i) c[i, j] += alpha * tile[j][i];
+            }
+        }
+    }
+}
+
+#endif // TINYLA_MATX_INL
@@ -0,0 +1,67 @@
+#ifndef TINYLA_OBB_HPP
+#define TINYLA_OBB_HPP
+
+#include <tinyla/eigen.hpp>
+#include <tinyla/mat.hpp>
+#include <tinyla/parallel.hpp>
+#include <tinyla/reduce.hpp>
+#include <tinyla/soa.hpp>
+#include <tinyla/vec.hpp>
+#include <cstddef>
+#include <span>
+
+namespace tinyla::geom
+{
+    /**
+    * Oriented bounding box: the points center + axes * x with |x[i]| <= extents[i].
+    * The columns of axes are orthonormal and form a rotation.
+    */
+    template<typename T>
+    struct obb {
+        vec<3,T> center;
+        mat<3,T> axes;
+        vec<3,T> extents;
+    };
+
+    /**
+    * Box aligned with the principal axes of a non-empty point set (the eigenvectors of its covariance),
+    * tight along each axis.
+    */
+    template<typename T>
+    obb<T> fit_obb(std::span<const vec<3,T>> points, parallel::options const& options = {});
+
+    /**
+    * Image of the box under the affine transform m. Exact for rotations, translations and uniform scaling;
+    * for other transforms the result is the smallest box enclosing the image along the transformed axes,
+    * made orthonormal again.
+    */
+    template<typename T>
+    constexpr obb<T> transformed(obb<T> const& box, mat<4,T> const& m);
+
+    // Separating axis test over the 15 candidate axes (Gottschalk et al., "OBBTree", 1996).
+    template<typename T>
+    constexpr bool overlaps(obb<T> const& a, obb<T> const& b);
+
+    /**
+    * out[i] = overlaps(a, others[i]). The boxes are tested default_lanes<T> at a time, one per SIMD lane:
+    * they are copied element by element into lanes and all 15 axes are evaluated without branching.
+    * Returns the number of overlaps.
+    */
+    template<typename T>
+    std::size_t overlaps(obb<T> const& a, std::span<const obb<T>> others, std::span<bool> out);
+
+    namespace detail {
+        // Box b in lane l of lanes: its center in rows 0-2, its axes column by column in rows 3-11, its extents in 12-14.
+        template<typename T, std::size_t L>
+        constexpr void set_lane(T (&lanes)[15][L], std::size_t l, obb<T> const& b);
+
+        // result[l] is 1 where the box in lane l of b is separated from box a and 0 where they overlap.
+        template<typename T, std::size_t L>
+        constexpr void separated(vec<3,T> const (&a_axes)[3], vec<3,T> const& a_center, vec<3,T> const& a_extents,
+                                 T const (&b)[15][L], T (&result)[L]);
+    }
+}
+
+#include "obb.inl"
+
+#endif // TINYLA_OBB_HPP
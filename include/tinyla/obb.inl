@@ -0,0 +1,188 @@
+#ifndef TINYLA_OBB_INL
+#define TINYLA_OBB_INL
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <vector>
+
+namespace tinyla::geom
+{
+    template<typename T>
+    obb<T> fit_obb(std::span<const vec<3,T>> points, parallel::options const& options)
+    {
+        assert(!points.empty());
+        auto const axes = symmetric_eigen(covariance(points, options)).vectors;
+
+        // Extent of the points along each axis, per block and then over the blocks.
+        auto partial = std::vector<aabb<3,T>>(
+            parallel::block_count(points.size(), tinyla::detail::reduction_block_size),
+            aabb<3,T>{vec<3,T>{vec_init::zero}, vec<3,T>{vec_init::zero}});
+        auto const local = [&axes](vec<3,T> const& p) {
+            return vec<3,T>{
+                axes[0, 0] * p.x() + axes[1, 0] * p.y() + axes[2, 0] * p.z(),
+                axes[0, 1] * p.x() + axes[1, 1] * p.y() + axes[2, 1] * p.z(),
+                axes[0, 2] * p.x() + axes[1, 2] * p.y() + axes[2, 2] * p.z()
+            };
+        };
+        parallel::for_each_block(points.size(), tinyla::detail::reduction_block_size,
+            [&](std::size_t block, std::size_t first, std::size_t last) {
+                auto b = aabb<3,T>{local(points[first]), local(points[first])};
+                for (std::size_t i = first + 1; i < last; ++i) {
+                    auto const q = local(points[i]);
+                    for (std::size_t c = 0; c < 3; ++c) {
+                        b.min[c] = std::min(b.min[c], q[c]);
+                        b.max[c] = std::max(b.max[c], q[c]);
+                    }
+                }
+                partial[block] = b;
+            }, options);
+
+        auto range = partial[0];
+        for (auto const& b : partial) {
+            for (std::size_t c = 0; c < 3; ++c) {
+                range.min[c] = std::min(range.min[c], b.min[c]);
+                range.max[c] = std::max(range.max[c], b.max[c]);
+            }
+        }
+
+        auto const mid = (range.min + range.max) / T{2};
+        return obb<T>{axes * mid, axes, (range.max - range.min) / T{2}};
+    }
+
+    template<typename T>
+    constexpr obb<T> transformed(obb<T> const& box, mat<4,T> const& m)
+    {
+        auto const apply = [&m](vec<3,T> const& v, T w) {
+            return vec<3,T>{
+                m[0, 0] * v.x() + m[0, 1] * v.y() + m[0, 2] * v.z() + m[0, 3] * w,
+                m[1, 0] * v.x() + m[1, 1] * v.y() + m[1, 2] * v.z() + m[1, 3] * w,
+                m[2, 0] * v.x() + m[2, 1] * v.y() + m[2, 2] * v.z() + m[2, 3] * w
+            };
+        };
+
+        vec<3,T> u[3] = {
+            apply(vec<3,T>{box.axes[0, 0], box.axes[1, 0], box.axes[2, 0]}, T{0}),
+            apply(vec<3,T>{box.axes[0, 1], box.axes[1, 1], box.axes[2, 1]}, T{0}),
+            apply(vec<3,T>{box.axes[0, 2], box.axes[1, 2], box.axes[2, 2]}, T{0})
+        };
+
+        // Gram-Schmidt, completing a right-handed basis with a cross product.
+        auto const a0 = u[0] / u[0].length();
+        auto const w = u[1] - a0 * dot(a0, u[1]);
+        auto const a1 = w / w.length();
+        auto const a2 = cross(a0, a1);
+        vec<3,T> const axes[3] = {a0, a1, a2};
+
+        auto result = obb<T>{apply(box.center, T{1}), mat<3,T>{mat_init::uninitialized}, vec<3,T>{vec_init::zero}};
+        for (std::size_t k = 0; k < 3; ++k) {
+            for (std::size_t r = 0; r < 3; ++r) result.axes[r, k] = axes[k][r];
+            for (std::size_t i = 0; i < 3; ++i) result.extents[k] += tinyla::abs(dot(axes[k], u[i])) * box.extents[i];
+        }
+        return result;
+    }
+
+    template<typename T>
+    constexpr bool overlaps(obb<T> const& a, obb<T> const& b)
+    {
+        vec<3,T> const axes[3] = {
+            vec<3,T>{a.axes[0, 0], a.axes[1, 0], a.axes[2, 0]},
+            vec<3,T>{a.axes[0, 1], a.axes[1, 1], a.axes[2, 1]},
+            vec<3,T>{a.axes[0, 2], a.axes[1, 2], a.axes[2, 2]}
+        };
+        T lanes[15][1];
+        detail::set_lane(lanes, 0, b);
+        T separated[1];
+        detail::separated(axes, a.center, a.extents, lanes, separated);
+        return separated[0] == T{0};
+    }
+
+    template<typename T>
+    std::size_t overlaps(obb<T> const& a, std::span<const obb<T>> others, std::span<bool> out)
+    {
+        assert(others.size() == out.size());
+        vec<3,T> const axes[3] = {
+            vec<3,T>{a.axes[0, 0], a.axes[1, 0], a.axes[2, 0]},
+            vec<3,T>{a.axes[0, 1], a.axes[1, 1], a.axes[2, 1]},
+            vec<3,T>{a.axes[0, 2], a.axes[1, 2], a.axes[2, 2]}
+        };
+        constexpr auto L = default_lanes<T>;
+        std::size_t count = 0;
+        for (std::size_t first = 0; first < others.size(); first += L) {
+            auto const n = std::min(L, others.size() - first);
+            // Unused lanes repeat the last box.
+            T lanes[15][L];
+            for (std::size_t l = 0; l < L; ++l) detail::set_lane(lanes, l, others[first + std::min(l, n - 1)]);
+            T separated[L];
+            detail::separated(axes, a.center, a.extents, lanes, separated);
+            for (std::size_t l = 0; l < n; ++l) {
+                bool const hit = separated[l] == T{0};
+                out[first + l] = hit;
+                count += hit ? 1 : 0;
+            }
+        }
+        return count;
+    }
+
+    namespace detail {
+        template<typename T, std::size_t L>
+        constexpr void set_lane(T (&lanes)[15][L], std::size_t l, obb<T> const& b)
+        {
+            for (std::size_t k = 0; k < 3; ++k) {
+                lanes[k][l] = b.center[k];
+                for (std::size_t r = 0; r < 3; ++r) lanes[3 + 3 * k + r][l] = b.axes[r, k];
+                lanes[12 + k][l] = b.extents[k];
+            }
+        }
+
+        template<typename T, std::size_t L>
+        constexpr void separated(vec<3,T> const (&a_axes)[3], vec<3,T> const& a_center, vec<3,T> const& a_extents,
+                                 T const (&b)[15][L], T (&result)[L])
+        {
+            // Rotation from b's frame to a's, with an epsilon against nearly parallel edges whose cross products vanish.
+            constexpr T epsilon = std::numeric_limits<T>::epsilon() * T{16};
+            for (std::size_t l = 0; l < L; ++l) {
+                T r[3][3];
+                T abs_r[3][3];
+                for (std::size_t i = 0; i < 3; ++i) {
+                    for (std::size_t j = 0; j < 3; ++j) {
+                        r[i][j] = a_axes[i].x() * b[3 + 3 * j][l] + a_axes[i].y() * b[4 + 3 * j][l]
+                                + a_axes[i].z() * b[5 + 3 * j][l];
+                        abs_r[i][j] = tinyla::abs(r[i][j]) + epsilon;
+                    }
+                }
+                T const d[3] = {b[0][l] - a_center.x(), b[1][l] - a_center.y(), b[2][l] - a_center.z()};
+                T t[3];
+                for (std::size_t i = 0; i < 3; ++i) {
+                    t[i] = d[0] * a_axes[i].x() + d[1] * a_axes[i].y() + d[2] * a_axes[i].z();
+                }
+                auto const& ea = a_extents;
+                T const eb[3] = {b[12][l], b[13][l], b[14][l]};
+
+                // All 15 axes are evaluated and combined, without early exits.
+                bool separated = false;
+                for (std::size_t i = 0; i < 3; ++i) {
+                    separated |= tinyla::abs(t[i]) > ea[i] + eb[0] * abs_r[i][0] + eb[1] * abs_r[i][1] + eb[2] * abs_r[i][2];
+                }
+                for (std::size_t j = 0; j < 3; ++j) {
+                    T const tb = t[0] * r[0][j] + t[1] * r[1][j] + t[2] * r[2][j];
+                    separated |= tinyla::abs(tb) > ea[0] * abs_r[0][j] + ea[1] * abs_r[1][j] + ea[2] * abs_r[2][j] + eb[j];
+                }
+                for (std::size_t i = 0; i < 3; ++i) {
+                    auto const i1 = (i + 1) % 3;
+                    auto const i2 = (i + 2) % 3;
+                    for (std::size_t j = 0; j < 3; ++j) {
+                        auto const j1 = (j + 1) % 3;
+                        auto const j2 = (j + 2) % 3;
+                        T const ra = ea[i1] * abs_r[i2][j] + ea[i2] * abs_r[i1][j];
+                        T const rb = eb[j1] * abs_r[i][j2] + eb[j2] * abs_r[i][j1];
+                        separated |= tinyla::abs(t[i2] * r[i1][j] - t[i1] * r[i2][j]) > ra + rb;
+                    }
+                }
+                result[l] = separated ? T{1} : T{0};
+            }
+        }
+    }
+}
+
+#endif // TINYLA_OBB_INL
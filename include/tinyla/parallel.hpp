@@ -0,0 +1,73 @@
+#ifndef TINYLA_PARALLEL_HPP
+#define TINYLA_PARALLEL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+/**
+* Minimal fork-join helpers for the bulk kernels.
+*
+* Work is split into blocks whose boundaries depend only on the problem size, never on the number of threads,
+* so that kernels combining per-block results in block order produce the same bits with any thread count.
+*/
+
+namespace tinyla::parallel
+{
+    // 0 means std::thread::hardware_concurrency().
+    struct options {
+        std::size_t threads = 0;
+    };
+
+    std::size_t thread_count(options const& options);
+
+    /**
+    * Calls f(block, first, last) for every block [first, last) of block_size elements of [0, count),
+    * spreading the blocks over up to options.threads threads. Returns after all calls are done.
+    */
+    template<typename F>
+    void for_each_block(std::size_t count, std::size_t block_size, F&& f, options const& options = {});
+
+    /**
+    * Number of blocks for_each_block uses.
+    */
+    constexpr std::size_t block_count(std::size_t count, std::size_t block_size);
+}
+
+namespace tinyla::parallel
+{
+    inline std::size_t thread_count(options const& options)
+    {
+        if (options.threads != 0) return options.threads;
+        return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    constexpr std::size_t block_count(std::size_t count, std::size_t block_size)
+    {
+        return (count + block_size - 1) / block_size;
+    }
+
+    template<typename F>
+    void for_each_block(std::size_t count, std::size_t block_size, F&& f, options const& options)
+    {
+        auto const blocks = block_count(count, block_size);
+        auto const threads = std::min(thread_count(options), blocks);
+        auto run = [&](std::size_t t) {
+            // Static round-robin assignment keeps the work of each thread deterministic too.
+            for (std::size_t b = t; b < blocks; b += threads) {
+                f(b, b * block_size, std::min(count, (b + 1) * block_size));
+            }
+        };
+        if (threads <= 1) {
+            for (std::size_t b = 0; b < blocks; ++b) f(b, b * block_size, std::min(count, (b + 1) * block_size));
+            return;
+        }
+        auto workers = std::vector<std::jthread>{};
+        workers.reserve(threads - 1);
+        for (std::size_t t = 1; t < threads; ++t) workers.emplace_back(run, t);
+        run(0);
+    }
+}
+
+#endif // TINYLA_PARALLEL_HPP
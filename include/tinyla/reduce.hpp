@@ -0,0 +1,62 @@
+#ifndef TINYLA_REDUCE_HPP
+#define TINYLA_REDUCE_HPP
+
+#include <tinyla/mat.hpp>
+#include <tinyla/parallel.hpp>
+#include <tinyla/vec.hpp>
+#include <cstddef>
+#include <span>
+
+/**
+* Reductions over arrays of vec, split into fixed-size blocks that run in parallel.
+* Block results are combined in a fixed order, so results do not depend on the number of threads.
+* Sums use pairwise summation, whose rounding error grows with log(n) rather than n.
+*/
+
+namespace tinyla
+{
+    template<std::size_t N, typename T>
+    requires(N >= 2)
+    struct aabb {
+        vec<N,T> min;
+        vec<N,T> max;
+    };
+
+    // Component-wise minimum and maximum of a non-empty array.
+    template<std::size_t N, typename T>
+    aabb<N,T> bounds(std::span<const vec<N,T>> points, parallel::options const& options = {});
+
+    template<std::size_t N, typename T>
+    vec<N,T> sum(std::span<const vec<N,T>> points, parallel::options const& options = {});
+
+    // Mean of a non-empty array.
+    template<std::size_t N, typename T>
+    vec<N,T> mean(std::span<const vec<N,T>> points, parallel::options const& options = {});
+
+    /**
+    * Population covariance matrix (normalised by the number of points) of a non-empty array,
+    * computed around the mean in a second pass.
+    */
+    template<typename T>
+    mat<3,T> covariance(std::span<const vec<3,T>> points, parallel::options const& options = {});
+
+    namespace detail {
+        constexpr std::size_t reduction_block_size = 4096;
+
+        /**
+        * Pairwise sum of f(i) for i in [first, last); Acc must support += and be copyable.
+        */
+        template<typename Acc, typename F>
+        Acc pairwise_sum(std::size_t first, std::size_t last, F const& f);
+
+        /**
+        * Pairwise sum of f(i) over blocks in parallel, then of the block sums in block order.
+        */
+        template<typename Acc, typename F>
+        Acc parallel_pairwise_sum(std::size_t count, F const& f, parallel::options const& options);
+    }
+}
+
+#include "reduce.inl"
+
+#endif // TINYLA_REDUCE_HPP
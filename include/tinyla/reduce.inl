@@ -0,0 +1,104 @@
+#ifndef TINYLA_REDUCE_INL
+#define TINYLA_REDUCE_INL
+
+#include <algorithm>
+#include <vector>
+
+namespace tinyla
+{
+    template<std::size_t N, typename T>
+    aabb<N,T> bounds(std::span<const vec<N,T>> points, parallel::options const& options)
+    {
+        assert(!points.empty());
+        auto partial = std::vector<aabb<N,T>>(
+            parallel::block_count(points.size(), detail::reduction_block_size), aabb<N,T>{points[0], points[0]});
+
+        parallel::for_each_block(points.size(), detail::reduction_block_size,
+            [&](std::size_t block, std::size_t first, std::size_t last) {
+                auto b = aabb<N,T>{points[first], points[first]};
+                for (std::size_t i = first + 1; i < last; ++i) {
+                    for (std::size_t c = 0; c < N; ++c) {
+                        b.min[c] = std::min(b.min[c], points[i][c]);
+                        b.max[c] = std::max(b.max[c], points[i][c]);
+                    }
+                }
+                partial[block] = b;
+            }, options);
+
+        auto result = partial[0];
+        for (auto const& b : partial) {
+            for (std::size_t c = 0; c < N; ++c) {
+                result.min[c] = std::min(result.min[c], b.min[c]);
+                result.max[c] = std::max(result.max[c], b.max[c]);
+            }
+        }
+        return result;
+    }
+
+    template<std::size_t N, typename T>
+    vec<N,T> sum(std::span<const vec<N,T>> points, parallel::options const& options)
+    {
+        return detail::parallel_pairwise_sum<vec<N,T>>(points.size(), [&](std::size_t i) { return points[i]; }, options);
+    }
+
+    template<std::size_t N, typename T>
+    vec<N,T> mean(std::span<const vec<N,T>> points, parallel::options const& options)
+    {
+        assert(!points.empty());
+        auto result = sum(points, options);
+        for (std::size_t c = 0; c < N; ++c) result[c] /= static_cast<T>(points.size());
+        return result;
+    }
+
+    template<typename T>
+    mat<3,T> covariance(std::span<const vec<3,T>> points, parallel::options const& options)
+    {
+        assert(!points.empty());
+        auto const m = mean(points, options);
+
+        // xx, xy, xz, yy, yz, zz
+        auto const s = detail::parallel_pairwise_sum<vec<6,T>>(points.size(), [&](std::size_t i) {
+            auto const d = points[i] - m;
+            return vec<6,T>{d.x() * d.x(), d.x() * d.y(), d.x() * d.z(), d.y() * d.y(), d.y() * d.z(), d.z() * d.z()};
+        }, options);
+
+        T const n = static_cast<T>(points.size());
+        return mat<3,T>{
+            s[0] / n, s[1] / n, s[2] / n,
+            s[1] / n, s[3] / n, s[4] / n,
+            s[2] / n, s[4] / n, s[5] / n
+        };
+    }
+
+    namespace detail {
+        template<typename Acc, typename F>
+        Acc pairwise_sum(std::size_t first, std::size_t last, F const& f)
+        {
+            constexpr std::size_t base = 8;
+            if (last - first <= base) {
+                auto acc = f(first);
+                for (std::size_t i = first + 1; i < last; ++i) acc += f(i);
+                return acc;
+            }
+            auto const middle = first + (last - first) / 2;
+            auto acc = pairwise_sum<Acc>(first, middle, f);
+            acc += pairwise_sum<Acc>(middle, last, f);
+            return acc;
+        }
+
+        template<typename Acc, typename F>
+        Acc parallel_pairwise_sum(std::size_t count, F const& f, parallel::options const& options)
+        {
+            if (count == 0) return Acc{vec_init::zero};
+
+            auto partial = std::vector<Acc>(parallel::block_count(count, reduction_block_size), Acc{vec_init::zero});
+            parallel::for_each_block(count, reduction_block_size,
+                [&](std::size_t block, std::size_t first, std::size_t last) {
+                    partial[block] = pairwise_sum<Acc>(first, last, f);
+                }, options);
+            return pairwise_sum<Acc>(0, partial.size(), [&](std::size_t i) { return partial[i]; });
+        }
+    }
+}
+
+#endif // TINYLA_REDUCE_INL
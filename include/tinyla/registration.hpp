@@ -0,0 +1,74 @@
+#ifndef TINYLA_REGISTRATION_HPP
+#define TINYLA_REGISTRATION_HPP
+
+#include <tinyla/eigen.hpp>
+#include <tinyla/geom.hpp>
+#include <tinyla/kdtree.hpp>
+#include <tinyla/mat.hpp>
+#include <tinyla/parallel.hpp>
+#include <tinyla/reduce.hpp>
+#include <tinyla/vec.hpp>
+#include <cstddef>
+#include <span>
+
+/**
+* Rigid and similarity registration of paired point sets (Kabsch, Umeyama) and iterative closest point.
+*/
+
+namespace tinyla::geom
+{
+    enum class registration {
+        rigid,      // rotation and translation
+        similarity  // rotation, translation and uniform scale
+    };
+
+    /**
+    * Transform m minimising sum(w[i] * |m * source[i] - target[i]|^2), as translation(t) * R * scaling(s),
+    * where R is a proper rotation (reflections are never returned) and s = 1 for registration::rigid.
+    * Centroids and cross-covariance are accumulated in one parallel pass over the data.
+    * The total weight must be positive; the unweighted overloads give every pair weight 1.
+    */
+    template<typename T>
+    mat<4,T> align(std::span<const vec<3,T>> source, std::span<const vec<3,std::type_identity_t<T>>> target,
+                   registration registration = registration::rigid, parallel::options const& options = {});
+
+    template<typename T>
+    mat<4,T> align(std::span<const vec<3,T>> source, std::span<const vec<3,std::type_identity_t<T>>> target,
+                   std::span<const std::type_identity_t<T>> weights,
+                   registration registration = registration::rigid, parallel::options const& options = {});
+
+    template<typename T>
+    struct icp_result {
+        mat<4,T> transform;    // refined source-to-target transform
+        T rms;                 // root mean square distance of the inlier pairs before the refinement
+        std::size_t inliers;   // pairs closer than the rejection distance
+    };
+
+    /**
+    * One iteration of point-to-point ICP: pairs every source point, moved by transform, with its nearest
+    * point in tree (built over target), drops pairs further apart than max_distance and composes the
+    * alignment of the remaining pairs onto transform. With no inliers the transform is returned unchanged.
+    */
+    template<typename T>
+    icp_result<T> icp_step(std::span<const vec<3,T>> source, std::span<const vec<3,std::type_identity_t<T>>> target,
+                           kdtree<T> const& tree, mat<4,T> const& transform, T max_distance,
+                           registration registration = registration::rigid, parallel::options const& options = {});
+
+    namespace detail {
+        /**
+        * Sums over the pairs returned by f(i) -> {p, q, w, extra} of w, w p, w q, w p q^T (row-major), w |p|^2
+        * and extra. Callers pass points relative to the first pair to keep the one-pass covariance accurate
+        * away from the origin.
+        */
+        template<typename T, typename F>
+        vec<18,T> pair_moments(std::size_t count, F const& f, parallel::options const& options);
+
+        template<typename T>
+        mat<4,T> solve_alignment(vec<18,T> const& moments, vec<3,T> const& p0, vec<3,T> const& q0,
+                                 registration registration);
+    }
+}
+
+#include "registration.inl"
+
+#endif // TINYLA_REGISTRATION_HPP
@@ -0,0 +1,135 @@
+#ifndef TINYLA_REGISTRATION_INL
+#define TINYLA_REGISTRATION_INL
+
+#include <cassert>
+#include <tuple>
+#include <vector>
+
+namespace tinyla::geom
+{
+    template<typename T>
+    mat<4,T> align(std::span<const vec<3,T>> source, std::span<const vec<3,std::type_identity_t<T>>> target,
+                   registration registration, parallel::options const& options)
+    {
+        assert(source.size() == target.size() && !source.empty());
+        auto const p0 = source[0];
+        auto const q0 = target[0];
+        auto const moments = detail::pair_moments<T>(source.size(), [&](std::size_t i) {
+            return std::tuple{source[i] - p0, target[i] - q0, T{1}, T{0}};
+        }, options);
+        return detail::solve_alignment(moments, p0, q0, registration);
+    }
+
+    template<typename T>
+    mat<4,T> align(std::span<const vec<3,T>> source, std::span<const vec<3,std::type_identity_t<T>>> target,
+                   std::span<const std::type_identity_t<T>> weights,
+                   registration registration, parallel::options const& options)
+    {
+        assert(source.size() == target.size() && source.size() == weights.size() && !source.empty());
+        auto const p0 = source[0];
+        auto const q0 = target[0];
+        auto const moments = detail::pair_moments<T>(source.size(), [&](std::size_t i) {
+            return std::tuple{source[i] - p0, target[i] - q0, weights[i], T{0}};
+        }, options);
+        return detail::solve_alignment(moments, p0, q0, registration);
+    }
+
+    template<typename T>
+    icp_result<T> icp_step(std::span<const vec<3,T>> source, std::span<const vec<3,std::type_identity_t<T>>> target,
+                           kdtree<T> const& tree, mat<4,T> const& transform, T max_distance,
+                           registration registration, parallel::options const& options)
+    {
+        assert(!source.empty() && tree.size() == target.size());
+        auto const apply = [&transform](vec<3,T> const& p) {
+            return vec<3,T>{
+                transform[0, 0] * p.x() + transform[0, 1] * p.y() + transform[0, 2] * p.z() + transform[0, 3],
+                transform[1, 0] * p.x() + transform[1, 1] * p.y() + transform[1, 2] * p.z() + transform[1, 3],
+                transform[2, 0] * p.x() + transform[2, 1] * p.y() + transform[2, 2] * p.z() + transform[2, 3]
+            };
+        };
+
+        auto moved = std::vector<vec<3,T>>(source.size(), vec<3,T>{vec_init::zero});
+        parallel::for_each_block(source.size(), tinyla::detail::reduction_block_size,
+            [&](std::size_t, std::size_t first, std::size_t last) {
+                for (std::size_t i = first; i < last; ++i) moved[i] = apply(source[i]);
+            }, options);
+        auto matches = std::vector<neighbor<T>>(source.size());
+        tree.nearest(std::span<const vec<3,T>>{moved}, 1, std::span<neighbor<T>>{matches}, options);
+
+        // Rejected pairs get weight zero, so the moments and the residual come out of the same pass.
+        T const bound = max_distance * max_distance;
+        auto const p0 = moved[0];
+        auto const q0 = target[matches[0].index];
+        auto const moments = detail::pair_moments<T>(source.size(), [&](std::size_t i) {
+            auto const& m = matches[i];
+            T const w = m.distance_squared <= bound ? T{1} : T{0};
+            return std::tuple{moved[i] - p0, target[m.index] - q0, w, w * m.distance_squared};
+        }, options);
+
+        T const inliers = moments[0];
+        if (inliers == T{0}) return icp_result<T>{transform, T{0}, 0};
+        return icp_result<T>{
+            detail::solve_alignment(moments, p0, q0, registration) * transform,
+            tinyla::sqrt(moments[17] / inliers),
+            static_cast<std::size_t>(inliers)
+        };
+    }
+
+    namespace detail {
+        template<typename T, typename F>
+        vec<18,T> pair_moments(std::size_t count, F const& f, parallel::options const& options)
+        {
+            return tinyla::detail::parallel_pairwise_sum<vec<18,T>>(count, [&](std::size_t i) {
+                auto const pair = f(i);
+                auto const& p = std::get<0>(pair);
+                auto const& q = std::get<1>(pair);
+                T const w = std::get<2>(pair);
+                auto result = vec<18,T>{vec_init::uninitialized};
+                result[0] = w;
+                for (std::size_t r = 0; r < 3; ++r) {
+                    result[1 + r] = w * p[r];
+                    result[4 + r] = w * q[r];
+                    for (std::size_t c = 0; c < 3; ++c) result[7 + 3 * r + c] = w * p[r] * q[c];
+                }
+                result[16] = w * dot(p, p);
+                result[17] = std::get<3>(pair);
+                return result;
+            }, options);
+        }
+
+        template<typename T>
+        mat<4,T> solve_alignment(vec<18,T> const& moments, vec<3,T> const& p0, vec<3,T> const& q0,
+                                 registration registration)
+        {
+            T const total = moments[0];
+            assert(total > T{0});
+            auto const p = vec<3,T>{moments[1] / total, moments[2] / total, moments[3] / total};
+            auto const q = vec<3,T>{moments[4] / total, moments[5] / total, moments[6] / total};
+
+            // Cross-covariance h = E[(p - mean p)(q - mean q)^T] = u diag(sigma) v^T; the optimal rotation is
+            // v u^T. svd keeps u and v proper and moves a reflection into the sign of sigma[2].
+            auto h = mat<3,T>{mat_init::uninitialized};
+            for (std::size_t r = 0; r < 3; ++r) {
+                for (std::size_t c = 0; c < 3; ++c) h[r, c] = moments[7 + 3 * r + c] / total - p[r] * q[c];
+            }
+            auto const d = svd(h);
+            auto const r = d.v * d.u.transposed();
+
+            T scale = T{1};
+            if (registration == registration::similarity) {
+                T const variance = moments[16] / total - dot(p, p);
+                assert(variance > T{0});
+                scale = (d.sigma[0] + d.sigma[1] + d.sigma[2]) / variance;
+            }
+
+            // t = mean q - s R mean p, in the original (unshifted) coordinates.
+            auto const mp = p + p0;
+            auto const rp = r * mp;
+            auto const mq = q + q0;
+            auto const t = vec<3,T>{mq.x() - scale * rp.x(), mq.y() - scale * rp.y(), mq.z() - scale * rp.z()};
+            return compose(trs<T>{t, r, vec<3,T>{scale, scale, scale}});
+        }
+    }
+}
+
+#endif // TINYLA_REGISTRATION_INL
@@ -0,0 +1,119 @@
+#ifndef TINYLA_SOA_HPP
+#define TINYLA_SOA_HPP
+
+#include <tinyla/mat.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+/**
+* Structure-of-arrays packs of 4x4 matrices and of vectors for batched kernels.
+*
+* A pack holds L matrices element by element: e[k][l] is element k (in column-major order) of the matrix
+* in lane l, so one vector register holds the same element of L matrices and a batched kernel processes
+* L matrices with each instruction. The default L fills 32 bytes: 8 floats or 4 doubles.
+* Vector packs are laid out the same way, component by component.
+*/
+
+namespace tinyla
+{
+    template<typename T>
+    constexpr std::size_t default_lanes = 32 / sizeof(T);
+
+    template<typename T, std::size_t L = default_lanes<T>>
+    struct mat4_pack {
+        static constexpr std::size_t lanes = L;
+
+        // Rows aligned to a vector register where L * sizeof(T) is one.
+        alignas(std::min<std::size_t>(std::bit_floor(L * sizeof(T)), 64)) T e[16][L];
+
+        constexpr mat<4,T> get(std::size_t lane) const;
+        constexpr void set(std::size_t lane, mat<4,T> const& m);
+    };
+
+    template<std::size_t M, typename T, std::size_t L>
+    struct vec_pack_view;
+
+    template<std::size_t N, typename T, std::size_t L = default_lanes<T>>
+    struct vec_pack {
+        static constexpr std::size_t lanes = L;
+
+        alignas(std::min<std::size_t>(std::bit_floor(L * sizeof(T)), 64)) T e[N][L];
+
+        constexpr vec<N,T> get(std::size_t lane) const;
+        constexpr void set(std::size_t lane, vec<N,T> const& v);
+
+        /**
+        * Swizzle of every lane at once, e.g. p.swizzle<0, 1, 2>() for the xyz of a pack of vec4.
+        * In this layout a swizzle only selects component rows, so the view refers to them instead of copying.
+        */
+        template<std::size_t... I>
+        constexpr vec_pack_view<sizeof...(I),T,L> swizzle() noexcept requires(((I < N) && ...));
+
+        template<std::size_t... I>
+        constexpr vec_pack_view<sizeof...(I),T const,L> swizzle() const noexcept requires(((I < N) && ...));
+    };
+
+    // Component k of the view is the row components[k] of L lanes in the underlying pack.
+    template<std::size_t M, typename T, std::size_t L>
+    struct vec_pack_view {
+        std::array<std::span<T,L>, M> components;
+
+        constexpr std::span<T,L> operator[](std::size_t k) const { return components[k]; }
+        constexpr vec<M,std::remove_const_t<T>> get(std::size_t lane) const;
+    };
+
+    // Number of packs of L lanes needed for count matrices.
+    template<typename T, std::size_t L = default_lanes<T>>
+    constexpr std::size_t pack_count(std::size_t count) { return (count + L - 1) / L; }
+
+    /**
+    * Packs matrices into pack_count(matrices.size()) packs; lanes past the end are set to the identity,
+    * so that kernels may process them without producing infinities or NaNs.
+    */
+    template<typename T, std::size_t L>
+    void to_soa(std::span<const mat<4,std::type_identity_t<T>>> matrices, std::span<mat4_pack<T,L>> packs);
+
+    /**
+    * Unpacks the first matrices.size() lanes of packs.
+    */
+    template<typename T, std::size_t L>
+    void from_soa(std::span<const mat4_pack<T,L>> packs, std::span<mat<4,std::type_identity_t<T>>> matrices);
+
+    // Determinants of all lanes; determinants[i] is that of lane i % L of pack i / L.
+    template<typename T, std::size_t L>
+    void determinant(std::span<const mat4_pack<T,L>> packs, std::span<std::type_identity_t<T>> determinants);
+
+    /**
+    * Inverts all lanes. Lanes whose determinant is close to zero are flagged in singular and,
+    * as with mat::inverted(), set to the identity. Returns the number of singular lanes.
+    * out may be the same range as packs.
+    */
+    template<typename T, std::size_t L>
+    std::size_t invert(std::span<const mat4_pack<T,L>> packs, std::span<mat4_pack<T,L>> out, std::span<bool> singular);
+
+    namespace detail {
+        /**
+        * The 2x2 minors of the upper (s) and lower (c) two rows of a 4x4 matrix,
+        * from which both its determinant and its adjugate are formed.
+        */
+        template<typename T>
+        struct minors4 {
+            T s0, s1, s2, s3, s4, s5;
+            T c0, c1, c2, c3, c4, c5;
+
+            constexpr T determinant() const { return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0; }
+        };
+
+        // a[k] is element k, in column-major order, of a 4x4 matrix.
+        template<typename T>
+        constexpr minors4<T> minors(T const (&a)[16]);
+    }
+}
+
+#include "soa.inl"
+
+#endif // TINYLA_SOA_HPP
@@ -0,0 +1,205 @@
+#ifndef TINYLA_SOA_INL
+#define TINYLA_SOA_INL
+
+#include <cassert>
+
+namespace tinyla
+{
+    template<typename T, std::size_t L>
+    constexpr mat<4,T> mat4_pack<T,L>::get(std::size_t lane) const
+    {
+        assert(lane < L);
+        auto m = mat<4,T>{mat_init::uninitialized};
+        for (std::size_t k = 0; k < 16; ++k) m.data()[k] = e[k][lane];
+        return m;
+    }
+
+    template<typename T, std::size_t L>
+    constexpr void mat4_pack<T,L>::set(std::size_t lane, mat<4,T> const& m)
+    {
+        assert(lane < L);
+        for (std::size_t k = 0; k < 16; ++k) e[k][lane] = m.data()[k];
+    }
+
+    template<std::size_t N, typename T, std::size_t L>
+    constexpr vec<N,T> vec_pack<N,T,L>::get(std::size_t lane) const
+    {
+        assert(lane < L);
+        auto v = vec<N,T>{vec_init::uninitialized};
+        for (std::size_t c = 0; c < N; ++c) v[c] = e[c][lane];
+        return v;
+    }
+
+    template<std::size_t N, typename T, std::size_t L>
+    constexpr void vec_pack<N,T,L>::set(std::size_t lane, vec<N,T> const& v)
+    {
+        assert(lane < L);
+        for (std::size_t c = 0; c < N; ++c) e[c][lane] = v[c];
+    }
+
+    template<std::size_t N, typename T, std::size_t L>
+    template<std::size_t... I>
+    constexpr vec_pack_view<sizeof...(I),T,L> vec_pack<N,T,L>::swizzle() noexcept requires(((I < N) && ...))
+    {
+        return {{std::span<T,L>{e[I]}...}};
+    }
+
+    template<std::size_t N, typename T, std::size_t L>
+    template<std::size_t... I>
+    constexpr vec_pack_view<sizeof...(I),T const,L> vec_pack<N,T,L>::swizzle() const noexcept requires(((I < N) && ...))
+    {
+        return {{std::span<T const,L>{e[I]}...}};
+    }
+
+    template<std::size_t M, typename T, std::size_t L>
+    constexpr vec<M,std::remove_const_t<T>> vec_pack_view<M,T,L>::get(std::size_t lane) const
+    {
+        assert(lane < L);
+        auto v = vec<M,std::remove_const_t<T>>{vec_init::uninitialized};
+        for (std::size_t k = 0; k < M; ++k) v[k] = components[k][lane];
+        return v;
+    }
+
+    template<typename T, std::size_t L>
+    void to_soa(std::span<const mat<4,std::type_identity_t<T>>> matrices, std::span<mat4_pack<T,L>> packs)
+    {
+        assert((packs.size() == pack_count<T,L>(matrices.size())));
+        constexpr auto identity = mat<4,T>{mat_init::identity};
+
+        for (std::size_t p = 0; p < packs.size(); ++p) {
+            auto& pack = packs[p];
+            auto const first = p * L;
+            std::size_t lane = 0;
+            // Four matrices at a time, as 4x4 transposes of their consecutive elements.
+            if constexpr (L % 4 == 0) {
+                for (; lane + 4 <= L && first + lane + 4 <= matrices.size(); lane += 4) {
+                    for (std::size_t k = 0; k < 16; k += 4) {
+                        detail::transpose4(matrices[first + lane].data() + k, 16, &pack.e[k][lane], L);
+                    }
+                }
+            }
+            for (; lane < L; ++lane) {
+                pack.set(lane, first + lane < matrices.size() ? matrices[first + lane] : identity);
+            }
+        }
+    }
+
+    template<typename T, std::size_t L>
+    void from_soa(std::span<const mat4_pack<T,L>> packs, std::span<mat<4,std::type_identity_t<T>>> matrices)
+    {
+        assert(matrices.size() <= packs.size() * L);
+
+        for (std::size_t p = 0; p < packs.size(); ++p) {
+            auto const& pack = packs[p];
+            auto const first = p * L;
+            std::size_t lane = 0;
+            if constexpr (L % 4 == 0) {
+                for (; lane + 4 <= L && first + lane + 4 <= matrices.size(); lane += 4) {
+                    for (std::size_t k = 0; k < 16; k += 4) {
+                        detail::transpose4(&pack.e[k][lane], L, matrices[first + lane].data() + k, 16);
+                    }
+                }
+            }
+            for (; lane < L && first + lane < matrices.size(); ++lane) {
+                matrices[first + lane] = pack.get(lane);
+            }
+        }
+    }
+
+    template<typename T, std::size_t L>
+    void determinant(std::span<const mat4_pack<T,L>> packs, std::span<std::type_identity_t<T>> determinants)
+    {
+        assert(determinants.size() == packs.size() * L);
+        for (std::size_t p = 0; p < packs.size(); ++p) {
+            auto const& e = packs[p].e;
+            // One lane per iteration with unit-stride loads, which the compiler turns into one lane per SIMD slot.
+            for (std::size_t l = 0; l < L; ++l) {
+                T a[16];
+                for (std::size_t k = 0; k < 16; ++k) a[k] = e[k][l];
+                determinants[p * L + l] = detail::minors(a).determinant();
+            }
+        }
+    }
+
+    template<typename T, std::size_t L>
+    std::size_t invert(std::span<const mat4_pack<T,L>> packs, std::span<mat4_pack<T,L>> out, std::span<bool> singular)
+    {
+        assert(out.size() == packs.size());
+        assert(singular.size() == packs.size() * L);
+
+        std::size_t count = 0;
+        for (std::size_t p = 0; p < packs.size(); ++p) {
+            auto const& e = packs[p].e;
+            // Computed into a local pack first, since out may alias packs.
+            auto result = mat4_pack<T,L>{};
+            auto& inv = result.e;
+            T det[L];
+            // One lane per iteration with unit-stride loads and stores and no branches, so that the loop
+            // vectorises across lanes. The singular flags, which are bools, are set in a separate pass.
+            for (std::size_t l = 0; l < L; ++l) {
+                T a[16];
+                for (std::size_t k = 0; k < 16; ++k) a[k] = e[k][l];
+                auto const m = detail::minors(a);
+                det[l] = m.determinant();
+
+                // Singular lanes get zero cofactors plus the identity. The division is guarded arithmetically
+                // rather than by a select, which the compiler would turn back into a branch around it.
+                T const one = close_to_zero(det[l]) ? T{1} : T{0};
+                T const d = (T{1} - one) / (det[l] + one);
+
+                // Element k of the inverse is inv[k][l], in the same column-major order as a.
+                inv[0][l]  = ( a[5] * m.c5 - a[9] * m.c4 + a[13] * m.c3) * d + one;
+                inv[1][l]  = (-a[1] * m.c5 + a[9] * m.c2 - a[13] * m.c1) * d;
+                inv[2][l]  = ( a[1] * m.c4 - a[5] * m.c2 + a[13] * m.c0) * d;
+                inv[3][l]  = (-a[1] * m.c3 + a[5] * m.c1 - a[9] * m.c0) * d;
+
+                inv[4][l]  = (-a[4] * m.c5 + a[8] * m.c4 - a[12] * m.c3) * d;
+                inv[5][l]  = ( a[0] * m.c5 - a[8] * m.c2 + a[12] * m.c1) * d + one;
+                inv[6][l]  = (-a[0] * m.c4 + a[4] * m.c2 - a[12] * m.c0) * d;
+                inv[7][l]  = ( a[0] * m.c3 - a[4] * m.c1 + a[8] * m.c0) * d;
+
+                inv[8][l]  = ( a[7] * m.s5 - a[11] * m.s4 + a[15] * m.s3) * d;
+                inv[9][l]  = (-a[3] * m.s5 + a[11] * m.s2 - a[15] * m.s1) * d;
+                inv[10][l] = ( a[3] * m.s4 - a[7] * m.s2 + a[15] * m.s0) * d + one;
+                inv[11][l] = (-a[3] * m.s3 + a[7] * m.s1 - a[11] * m.s0) * d;
+
+                inv[12][l] = (-a[6] * m.s5 + a[10] * m.s4 - a[14] * m.s3) * d;
+                inv[13][l] = ( a[2] * m.s5 - a[10] * m.s2 + a[14] * m.s1) * d;
+                inv[14][l] = (-a[2] * m.s4 + a[6] * m.s2 - a[14] * m.s0) * d;
+                inv[15][l] = ( a[2] * m.s3 - a[6] * m.s1 + a[10] * m.s0) * d + one;
+            }
+            out[p] = result;
+
+            for (std::size_t l = 0; l < L; ++l) {
+                bool const is_singular = close_to_zero(det[l]);
+                singular[p * L + l] = is_singular;
+                count += is_singular ? 1 : 0;
+            }
+        }
+        return count;
+    }
+
+    namespace detail {
+        template<typename T>
+        constexpr minors4<T> minors(T const (&a)[16])
+        {
+            // a[4 * c + r] is the element in row r of column c.
+            return {
+                a[0] * a[5] - a[1] * a[4],
+                a[0] * a[9] - a[1] * a[8],
+                a[0] * a[13] - a[1] * a[12],
+                a[4] * a[9] - a[5] * a[8],
+                a[4] * a[13] - a[5] * a[12],
+                a[8] * a[13] - a[9] * a[12],
+                a[2] * a[7] - a[3] * a[6],
+                a[2] * a[11] - a[3] * a[10],
+                a[2] * a[15] - a[3] * a[14],
+                a[6] * a[11] - a[7] * a[10],
+                a[6] * a[15] - a[7] * a[14],
+                a[10] * a[15] - a[11] * a[14]
+            };
+        }
+    }
+}
+
+#endif // TINYLA_SOA_INL
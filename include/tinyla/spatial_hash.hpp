@@ -0,0 +1,83 @@
+#ifndef TINYLA_SPATIAL_HASH_HPP
+#define TINYLA_SPATIAL_HASH_HPP
+
+#include <tinyla/mat.hpp>
+#include <tinyla/parallel.hpp>
+#include <tinyla/spatial_sort.hpp>
+#include <tinyla/vec.hpp>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+* Uniform-grid spatial hash for fixed-radius neighbour search over points that move every step.
+*
+* Points are binned by the hash of their vec3i cell into a power-of-two number of buckets; a rebuild sorts
+* the points by bucket with the parallel radix sort, so it costs O(n) and keeps no state between steps.
+* Different cells may share a bucket, so queries filter the candidates by distance.
+*/
+
+namespace tinyla
+{
+    template<std::floating_point T>
+    class spatial_hash {
+    public:
+        using point = vec<3,T>;
+
+        /**
+        * cell_size bounds the radius of the queries; bucket_count is rounded up to a power of two.
+        */
+        spatial_hash(T cell_size, std::size_t bucket_count);
+
+        // Rebuilds from structure-of-arrays positions.
+        void rebuild(std::span<const T> xs, std::span<const T> ys, std::span<const T> zs,
+                     parallel::options const& options = {});
+
+        void rebuild(std::span<const point> points, parallel::options const& options = {});
+
+        // Cell coordinates are clamped to +-(INT_MAX - 1); NaN coordinates are put in cell 0.
+        vec3i cell_of(point const& p) const;
+        constexpr std::uint32_t bucket_of(vec3i cell) const;
+
+        T cell_size() const noexcept { return m_cell_size; }
+        std::size_t bucket_count() const noexcept { return m_starts.size() - 1; }
+        std::size_t size() const noexcept { return m_order.size(); }
+
+        /**
+        * Point indices sorted by bucket; gathering per-point data in this order makes the points of
+        * a cell and its neighbours contiguous for follow-on passes.
+        */
+        std::span<const std::uint32_t> order() const noexcept { return m_order; }
+
+        // Indices of the points in a bucket.
+        std::span<const std::uint32_t> bucket(std::uint32_t b) const;
+
+        /**
+        * Calls f(index, distance_squared) for every point within radius of p, scanning the 27 cells around it.
+        * radius must not exceed the cell size.
+        */
+        template<typename F>
+        void for_each_neighbor(point const& p, T radius, F&& f) const;
+    private:
+        T m_cell_size;
+        T m_inverse_cell_size;
+        std::uint32_t m_mask;
+        std::vector<std::uint32_t> m_order;
+        std::vector<std::uint32_t> m_starts;
+        // Positions in bucket order.
+        std::vector<T> m_xs;
+        std::vector<T> m_ys;
+        std::vector<T> m_zs;
+    };
+
+    namespace detail {
+        template<std::floating_point T>
+        int cell_coordinate(T scaled);
+    }
+}
+
+#include "spatial_hash.inl"
+
+#endif // TINYLA_SPATIAL_HASH_HPP
@@ -0,0 +1,149 @@
+#ifndef TINYLA_SPATIAL_HASH_INL
+#define TINYLA_SPATIAL_HASH_INL
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace tinyla
+{
+    template<std::floating_point T>
+    spatial_hash<T>::spatial_hash(T cell_size, std::size_t bucket_count)
+        : m_cell_size{cell_size}
+        , m_inverse_cell_size{T{1} / cell_size}
+        , m_mask{static_cast<std::uint32_t>(std::bit_ceil(std::max<std::size_t>(bucket_count, 1)) - 1)}
+        , m_starts(std::size_t{m_mask} + 2, 0)
+    {
+        assert(cell_size > T{0});
+        assert(bucket_count <= (std::size_t{1} << 31));
+    }
+
+    template<std::floating_point T>
+    void spatial_hash<T>::rebuild(std::span<const T> xs, std::span<const T> ys, std::span<const T> zs,
+                                  parallel::options const& options)
+    {
+        assert(xs.size() == ys.size() && xs.size() == zs.size());
+        auto const n = xs.size();
+        constexpr std::size_t block_size = std::size_t{1} << 14;
+
+        auto keys = std::vector<std::uint64_t>(n);
+        parallel::for_each_block(n, block_size, [&](std::size_t, std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; ++i) keys[i] = bucket_of(cell_of(point{xs[i], ys[i], zs[i]}));
+        }, options);
+
+        m_order = sort_permutation(keys, static_cast<unsigned>(std::bit_width(m_mask)), options);
+
+        m_xs.resize(n);
+        m_ys.resize(n);
+        m_zs.resize(n);
+        auto const buckets = bucket_count();
+        parallel::for_each_block(n, block_size, [&](std::size_t, std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; ++i) {
+                auto const j = m_order[i];
+                m_xs[i] = xs[j];
+                m_ys[i] = ys[j];
+                m_zs[i] = zs[j];
+
+                // Each bucket start is written by the first point of the next non-empty bucket.
+                auto const key = keys[j];
+                auto const previous = i == 0 ? std::uint64_t{0} : keys[m_order[i - 1]] + 1;
+                if (i == 0 || key != keys[m_order[i - 1]]) {
+                    for (auto b = previous; b <= key; ++b) m_starts[b] = static_cast<std::uint32_t>(i);
+                }
+            }
+        }, options);
+
+        auto const tail = n == 0 ? std::size_t{0} : static_cast<std::size_t>(keys[m_order[n - 1]]) + 1;
+        std::fill(m_starts.begin() + static_cast<std::ptrdiff_t>(tail), m_starts.begin() + buckets + 1,
+                  static_cast<std::uint32_t>(n));
+    }
+
+    template<std::floating_point T>
+    void spatial_hash<T>::rebuild(std::span<const point> points, parallel::options const& options)
+    {
+        auto xs = std::vector<T>(points.size());
+        auto ys = std::vector<T>(points.size());
+        auto zs = std::vector<T>(points.size());
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            xs[i] = points[i].x();
+            ys[i] = points[i].y();
+            zs[i] = points[i].z();
+        }
+        rebuild(xs, ys, zs, options);
+    }
+
+    template<std::floating_point T>
+    vec3i spatial_hash<T>::cell_of(point const& p) const
+    {
+        return vec3i{
+            detail::cell_coordinate(p.x() * m_inverse_cell_size),
+            detail::cell_coordinate(p.y() * m_inverse_cell_size),
+            detail::cell_coordinate(p.z() * m_inverse_cell_size)
+        };
+    }
+
+    template<std::floating_point T>
+    constexpr std::uint32_t spatial_hash<T>::bucket_of(vec3i cell) const
+    {
+        // Teschner et al., "Optimized Spatial Hashing for Collision Detection of Deformable Objects" (2003).
+        auto const h = (static_cast<std::uint32_t>(cell.x()) * 73856093u)
+                     ^ (static_cast<std::uint32_t>(cell.y()) * 19349663u)
+                     ^ (static_cast<std::uint32_t>(cell.z()) * 83492791u);
+        return h & m_mask;
+    }
+
+    template<std::floating_point T>
+    std::span<const std::uint32_t> spatial_hash<T>::bucket(std::uint32_t b) const
+    {
+        assert(b < bucket_count());
+        return std::span<const std::uint32_t>{m_order}.subspan(m_starts[b], m_starts[b + 1] - m_starts[b]);
+    }
+
+    template<std::floating_point T>
+    template<typename F>
+    void spatial_hash<T>::for_each_neighbor(point const& p, T radius, F&& f) const
+    {
+        assert(radius <= m_cell_size);
+
+        // Neighbouring cells may hash to the same bucket, which must be scanned only once.
+        std::array<std::uint32_t, 27> buckets;
+        std::size_t count = 0;
+        auto const c = cell_of(p);
+        for (int dz = -1; dz <= 1; ++dz) {
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    buckets[count++] = bucket_of(vec3i{c.x() + dx, c.y() + dy, c.z() + dz});
+                }
+            }
+        }
+        std::sort(buckets.begin(), buckets.end());
+        auto const last = std::unique(buckets.begin(), buckets.end());
+
+        T const r2 = radius * radius;
+        for (auto b = buckets.begin(); b != last; ++b) {
+            for (std::uint32_t i = m_starts[*b]; i < m_starts[*b + 1]; ++i) {
+                // Through length_squared, so that d is (q - p).length_squared() to the bit under any contraction.
+                T const d = (point{m_xs[i], m_ys[i], m_zs[i]} - p).length_squared();
+                if (d <= r2) f(m_order[i], d);
+            }
+        }
+    }
+
+    namespace detail {
+        template<std::floating_point T>
+        int cell_coordinate(T scaled)
+        {
+            // Clamped before the conversion, which is undefined for NaN and out of range values, and one short of
+            // the int limits so that the neighbouring cells are representable too.
+            constexpr int limit = std::numeric_limits<int>::max() - 1;
+            T const q = std::floor(scaled);
+            if (q != q) return 0;
+            return q <= static_cast<T>(-limit) ? -limit : q >= static_cast<T>(limit) ? limit : static_cast<int>(q);
+        }
+    }
+}
+
+#endif // TINYLA_SPATIAL_HASH_INL
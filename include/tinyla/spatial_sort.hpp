@@ -0,0 +1,77 @@
+#ifndef TINYLA_SPATIAL_SORT_HPP
+#define TINYLA_SPATIAL_SORT_HPP
+
+#include <tinyla/parallel.hpp>
+#include <tinyla/reduce.hpp>
+#include <tinyla/vec.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+* Reordering of point arrays along space-filling curves for cache locality.
+*
+* Points are quantised to integer cells of a grid over their bounds, the cells are encoded as Morton
+* (Z-order) or Hilbert keys, and the keys are sorted by a stable parallel radix sort.
+*/
+
+namespace tinyla
+{
+    enum class curve {
+        morton,
+        hilbert
+    };
+
+    // Interleaves the lower 10 bits of each coordinate, x in the least significant bit.
+    constexpr std::uint32_t morton30(vec3i cell);
+
+    // Interleaves the lower 21 bits of each coordinate, x in the least significant bit.
+    constexpr std::uint64_t morton63(vec3i cell);
+
+    constexpr vec3i morton30_decode(std::uint32_t key);
+
+    constexpr vec3i morton63_decode(std::uint64_t key);
+
+    // Position of the cell along a 21-bit-per-axis Hilbert curve starting at the origin.
+    constexpr std::uint64_t hilbert63(vec3i cell);
+
+    /**
+    * Cells of a 2^bits grid over box; points outside the box are clamped to the border cells
+    * and NaN coordinates are put in cell 0.
+    */
+    template<typename T>
+    void quantize(std::span<const vec<3,T>> points, aabb<3,T> const& box, unsigned bits,
+                  std::span<vec3i> cells, parallel::options const& options = {});
+
+    // 63-bit keys of the cells.
+    void encode(std::span<const vec3i> cells, curve curve, std::span<std::uint64_t> keys,
+                parallel::options const& options = {});
+
+    /**
+    * Permutation p such that keys[p[0]] <= keys[p[1]] <= ..., stable for equal keys.
+    * Only the lower key_bits bits of the keys are considered.
+    */
+    std::vector<std::uint32_t> sort_permutation(std::span<const std::uint64_t> keys, unsigned key_bits = 64,
+                                                parallel::options const& options = {});
+
+    /**
+    * Permutation that orders the points along the curve through their bounds.
+    */
+    template<typename T>
+    std::vector<std::uint32_t> spatial_sort(std::span<const vec<3,T>> points, curve curve = curve::morton,
+                                            parallel::options const& options = {});
+
+    namespace detail {
+        constexpr std::uint32_t spread_bits10(std::uint32_t x);
+        constexpr std::uint32_t compact_bits10(std::uint32_t x);
+        constexpr std::uint64_t spread_bits21(std::uint64_t x);
+        constexpr std::uint64_t compact_bits21(std::uint64_t x);
+
+        constexpr std::size_t sort_block_size = std::size_t{1} << 14;
+    }
+}
+
+#include "spatial_sort.inl"
+
+#endif // TINYLA_SPATIAL_SORT_HPP
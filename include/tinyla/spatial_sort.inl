@@ -0,0 +1,246 @@
+#ifndef TINYLA_SPATIAL_SORT_INL
+#define TINYLA_SPATIAL_SORT_INL
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+namespace tinyla
+{
+    constexpr std::uint32_t morton30(vec3i cell)
+    {
+        return detail::spread_bits10(static_cast<std::uint32_t>(cell.x()))
+            | (detail::spread_bits10(static_cast<std::uint32_t>(cell.y())) << 1)
+            | (detail::spread_bits10(static_cast<std::uint32_t>(cell.z())) << 2);
+    }
+
+    constexpr std::uint64_t morton63(vec3i cell)
+    {
+        return detail::spread_bits21(static_cast<std::uint32_t>(cell.x()))
+            | (detail::spread_bits21(static_cast<std::uint32_t>(cell.y())) << 1)
+            | (detail::spread_bits21(static_cast<std::uint32_t>(cell.z())) << 2);
+    }
+
+    constexpr vec3i morton30_decode(std::uint32_t key)
+    {
+        return vec3i{
+            static_cast<int>(detail::compact_bits10(key)),
+            static_cast<int>(detail::compact_bits10(key >> 1)),
+            static_cast<int>(detail::compact_bits10(key >> 2))
+        };
+    }
+
+    constexpr vec3i morton63_decode(std::uint64_t key)
+    {
+        return vec3i{
+            static_cast<int>(detail::compact_bits21(key)),
+            static_cast<int>(detail::compact_bits21(key >> 1)),
+            static_cast<int>(detail::compact_bits21(key >> 2))
+        };
+    }
+
+    constexpr std::uint64_t hilbert63(vec3i cell)
+    {
+        /**
+         * Skilling, "Programming the Hilbert curve" (2004): converts the coordinates in place to the
+         * "transposed" Hilbert index, whose bits interleaved with x most significant give the index.
+         */
+        constexpr std::uint32_t top = std::uint32_t{1} << 20;
+        std::uint32_t x[3] = {
+            static_cast<std::uint32_t>(cell.x()) & 0x1fffff,
+            static_cast<std::uint32_t>(cell.y()) & 0x1fffff,
+            static_cast<std::uint32_t>(cell.z()) & 0x1fffff
+        };
+
+        // Inverse undo
+        for (std::uint32_t q = top; q > 1; q >>= 1) {
+            std::uint32_t const p = q - 1;
+            for (std::size_t i = 0; i < 3; ++i) {
+                if (x[i] & q) {
+                    x[0] ^= p;
+                } else {
+                    std::uint32_t const t = (x[0] ^ x[i]) & p;
+                    x[0] ^= t;
+                    x[i] ^= t;
+                }
+            }
+        }
+
+        // Gray encode
+        x[1] ^= x[0];
+        x[2] ^= x[1];
+        std::uint32_t t = 0;
+        for (std::uint32_t q = top; q > 1; q >>= 1) {
+            if (x[2] & q) t ^= q - 1;
+        }
+        x[0] ^= t;
+        x[1] ^= t;
+        x[2] ^= t;
+
+        return (detail::spread_bits21(x[0]) << 2) | (detail::spread_bits21(x[1]) << 1) | detail::spread_bits21(x[2]);
+    }
+
+    template<typename T>
+    void quantize(std::span<const vec<3,T>> points, aabb<3,T> const& box, unsigned bits,
+                  std::span<vec3i> cells, parallel::options const& options)
+    {
+        assert(points.size() == cells.size());
+        assert(bits >= 1 && bits <= 21);
+
+        int const last = (1 << bits) - 1;
+        T scale[3];
+        for (std::size_t c = 0; c < 3; ++c) {
+            T const extent = box.max[c] - box.min[c];
+            scale[c] = extent > T{0} ? static_cast<T>(1 << bits) / extent : T{0};
+        }
+
+        parallel::for_each_block(points.size(), detail::sort_block_size,
+            [&](std::size_t, std::size_t first, std::size_t end) {
+                for (std::size_t i = first; i < end; ++i) {
+                    for (std::size_t c = 0; c < 3; ++c) {
+                        // Clamped before the conversion, which is undefined for NaN and out of range values.
+                        T const q = (points[i][c] - box.min[c]) * scale[c];
+                        cells[i][c] = !(q > T{0}) ? 0 : q >= static_cast<T>(last) ? last : static_cast<int>(q);
+                    }
+                }
+            }, options);
+    }
+
+    inline void encode(std::span<const vec3i> cells, curve curve, std::span<std::uint64_t> keys,
+                       parallel::options const& options)
+    {
+        assert(cells.size() == keys.size());
+        parallel::for_each_block(cells.size(), detail::sort_block_size,
+            [&](std::size_t, std::size_t first, std::size_t last) {
+                if (curve == curve::morton) {
+                    for (std::size_t i = first; i < last; ++i) keys[i] = morton63(cells[i]);
+                } else {
+                    for (std::size_t i = first; i < last; ++i) keys[i] = hilbert63(cells[i]);
+                }
+            }, options);
+    }
+
+    inline std::vector<std::uint32_t> sort_permutation(std::span<const std::uint64_t> keys, unsigned key_bits,
+                                                       parallel::options const& options)
+    {
+        assert(keys.size() <= std::numeric_limits<std::uint32_t>::max());
+        assert(key_bits <= 64);
+
+        /**
+         * LSD radix sort by 8-bit digits. Every pass counts digits per block, turns the counts into
+         * per-block output offsets in (digit, block) order and scatters each block in order, so that
+         * the sort is stable and the result does not depend on the number of threads.
+         */
+        constexpr std::size_t radix = 256;
+        auto const n = keys.size();
+        auto const blocks = parallel::block_count(n, detail::sort_block_size);
+
+        auto order = std::vector<std::uint32_t>(n);
+        auto scratch = std::vector<std::uint32_t>(n);
+        for (std::size_t i = 0; i < n; ++i) order[i] = static_cast<std::uint32_t>(i);
+        auto sorted_keys = std::vector<std::uint64_t>(keys.begin(), keys.end());
+        auto scratch_keys = std::vector<std::uint64_t>(n);
+
+        auto histograms = std::vector<std::array<std::size_t, radix>>(blocks);
+        for (unsigned shift = 0; shift < key_bits; shift += 8) {
+            parallel::for_each_block(n, detail::sort_block_size,
+                [&](std::size_t block, std::size_t first, std::size_t last) {
+                    auto& h = histograms[block];
+                    h.fill(0);
+                    for (std::size_t i = first; i < last; ++i) ++h[(sorted_keys[i] >> shift) & (radix - 1)];
+                }, options);
+
+            // A digit shared by all keys leaves the order unchanged.
+            bool trivial = false;
+            for (std::size_t d = 0; d < radix && !trivial; ++d) {
+                std::size_t total = 0;
+                for (auto const& h : histograms) total += h[d];
+                trivial = total == n;
+            }
+            if (trivial) continue;
+
+            std::size_t offset = 0;
+            for (std::size_t d = 0; d < radix; ++d) {
+                for (auto& h : histograms) {
+                    auto const count = h[d];
+                    h[d] = offset;
+                    offset += count;
+                }
+            }
+
+            parallel::for_each_block(n, detail::sort_block_size,
+                [&](std::size_t block, std::size_t first, std::size_t last) {
+                    auto& h = histograms[block];
+                    for (std::size_t i = first; i < last; ++i) {
+                        auto const out = h[(sorted_keys[i] >> shift) & (radix - 1)]++;
+                        scratch_keys[out] = sorted_keys[i];
+                        scratch[out] = order[i];
+                    }
+                }, options);
+            sorted_keys.swap(scratch_keys);
+            order.swap(scratch);
+        }
+        return order;
+    }
+
+    template<typename T>
+    std::vector<std::uint32_t> spatial_sort(std::span<const vec<3,T>> points, curve curve,
+                                            parallel::options const& options)
+    {
+        if (points.empty()) return {};
+
+        constexpr unsigned bits = 21;
+        auto cells = std::vector<vec3i>(points.size(), vec3i{vec_init::uninitialized});
+        quantize(points, bounds(points, options), bits, std::span<vec3i>{cells}, options);
+
+        auto keys = std::vector<std::uint64_t>(points.size());
+        encode(cells, curve, keys, options);
+        return sort_permutation(keys, 3 * bits, options);
+    }
+
+    namespace detail {
+        constexpr std::uint32_t spread_bits10(std::uint32_t x)
+        {
+            x &= 0x3ff;
+            x = (x | (x << 16)) & 0x030000ff;
+            x = (x | (x << 8)) & 0x0300f00f;
+            x = (x | (x << 4)) & 0x030c30c3;
+            x = (x | (x << 2)) & 0x09249249;
+            return x;
+        }
+
+        constexpr std::uint32_t compact_bits10(std::uint32_t x)
+        {
+            x &= 0x09249249;
+            x = (x ^ (x >> 2)) & 0x030c30c3;
+            x = (x ^ (x >> 4)) & 0x0300f00f;
+            x = (x ^ (x >> 8)) & 0x030000ff;
+            x = (x ^ (x >> 16)) & 0x3ff;
+            return x;
+        }
+
+        constexpr std::uint64_t spread_bits21(std::uint64_t x)
+        {
+            x &= 0x1fffff;
+            x = (x | (x << 32)) & 0x001f00000000ffff;
+            x = (x | (x << 16)) & 0x001f0000ff0000ff;
+            x = (x | (x << 8)) & 0x100f00f00f00f00f;
+            x = (x | (x << 4)) & 0x10c30c30c30c30c3;
+            x = (x | (x << 2)) & 0x1249249249249249;
+            return x;
+        }
+
+        constexpr std::uint64_t compact_bits21(std::uint64_t x)
+        {
+            x &= 0x1249249249249249;
+            x = (x ^ (x >> 2)) & 0x10c30c30c30c30c3;
+            x = (x ^ (x >> 4)) & 0x100f00f00f00f00f;
+            x = (x ^ (x >> 8)) & 0x001f0000ff0000ff;
+            x = (x ^ (x >> 16)) & 0x001f00000000ffff;
+            x = (x ^ (x >> 32)) & 0x1fffff;
+            return x;
+        }
+    }
+}
+
+#endif // TINYLA_SPATIAL_SORT_INL
@@ -0,0 +1,90 @@
+#ifndef TINYLA_STREAM_HPP
+#define TINYLA_STREAM_HPP
+
+#include <tinyla/batch.hpp>
+#include <tinyla/io.hpp>
+#include <tinyla/mat.hpp>
+#include <tinyla/vec.hpp>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <system_error>
+#include <vector>
+
+namespace tinyla::stream
+{
+    /**
+    * A stage processes a chunk in place and returns how many elements to keep.
+    * The kept elements must be at the front of the chunk.
+    */
+    template<typename E>
+    using stage = std::function<std::size_t(std::span<E> chunk)>;
+
+    constexpr std::size_t default_chunk_size = std::size_t{1} << 16;
+    constexpr std::size_t default_depth = 3;
+
+    /**
+    * Chunked point cloud processing over io container files that need not fit in memory.
+    *
+    * A reader thread fills chunks while the calling thread runs the stages on the previous ones and a writer
+    * thread stores the results, so I/O overlaps compute. At most depth chunks of chunk_size points are alive.
+    */
+    template<typename T>
+    class pipeline {
+    public:
+        using point = vec<3, T>;
+
+        explicit pipeline(std::size_t chunk_size = default_chunk_size, std::size_t depth = default_depth);
+
+        // Applies an affine transformation (see transform_points).
+        pipeline& transform(mat<4, T> const& m);
+
+        // Applies a projective transformation with perspective division (see project_points).
+        pipeline& project(mat<4, T> const& m);
+
+        // Keeps the points for which keep returns true, preserving their order.
+        pipeline& filter(std::function<bool(point const&)> keep);
+
+        pipeline& then(stage<point> stage);
+
+        /**
+        * Streams the AoS vec<3,T> file at input through the stages into a new file at output.
+        * The output has the layout and alignment of the input. An exception thrown by a stage is rethrown
+        * once the reader and writer threads have stopped; the output file is then incomplete.
+        */
+        std::error_code run(std::filesystem::path const& input, std::filesystem::path const& output) const;
+
+        std::size_t chunk_size() const { return m_chunk_size; }
+        std::size_t depth() const { return m_depth; }
+    private:
+        std::size_t m_chunk_size;
+        std::size_t m_depth;
+        std::vector<stage<point>> m_stages;
+    };
+
+    namespace detail {
+        // Unbounded multi-producer multi-consumer queue; the pipeline bounds it by the number of chunks.
+        template<typename T>
+        class channel {
+        public:
+            void push(T value);
+            // Blocks until a value is available or the channel is closed and drained.
+            std::optional<T> pop();
+            void close();
+        private:
+            std::mutex m_mutex;
+            std::condition_variable m_cv;
+            std::deque<T> m_queue;
+            bool m_closed = false;
+        };
+    }
+}
+
+#include "stream.inl"
+
+#endif // TINYLA_STREAM_HPP
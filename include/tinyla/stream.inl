@@ -0,0 +1,194 @@
+#ifndef TINYLA_STREAM_INL
+#define TINYLA_STREAM_INL
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <fstream>
+#include <thread>
+#include <utility>
+
+namespace tinyla::stream
+{
+    template<typename T>
+    pipeline<T>::pipeline(std::size_t chunk_size, std::size_t depth)
+        : m_chunk_size{chunk_size}, m_depth{depth}
+    {
+        assert(chunk_size > 0);
+        // One chunk each for reading, computing and writing.
+        assert(depth >= 3);
+    }
+
+    template<typename T>
+    pipeline<T>& pipeline<T>::transform(mat<4, T> const& m)
+    {
+        return then([m](std::span<point> chunk) {
+            transform_points(m, std::span<const point>{chunk}, chunk);
+            return chunk.size();
+        });
+    }
+
+    template<typename T>
+    pipeline<T>& pipeline<T>::project(mat<4, T> const& m)
+    {
+        return then([m](std::span<point> chunk) {
+            project_points(m, std::span<const point>{chunk}, chunk);
+            return chunk.size();
+        });
+    }
+
+    template<typename T>
+    pipeline<T>& pipeline<T>::filter(std::function<bool(point const&)> keep)
+    {
+        return then([keep = std::move(keep)](std::span<point> chunk) {
+            auto const last = std::stable_partition(chunk.begin(), chunk.end(), keep);
+            return static_cast<std::size_t>(last - chunk.begin());
+        });
+    }
+
+    template<typename T>
+    pipeline<T>& pipeline<T>::then(stage<point> stage)
+    {
+        m_stages.push_back(std::move(stage));
+        return *this;
+    }
+
+    template<typename T>
+    std::error_code pipeline<T>::run(std::filesystem::path const& input, std::filesystem::path const& output) const
+    {
+        auto in = std::ifstream{input, std::ios::binary};
+        if (!in) return std::make_error_code(std::errc::no_such_file_or_directory);
+
+        auto header = io::header{};
+        in.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!in) return std::make_error_code(std::errc::invalid_argument);
+        auto size_error = std::error_code{};
+        auto const file_size = std::filesystem::file_size(input, size_error);
+        if (size_error) return size_error;
+        if (auto const invalid = io::detail::validate<point>(header, file_size)) return invalid;
+        if (header.layout != io::layout::aos) return std::make_error_code(std::errc::not_supported);
+        in.seekg(static_cast<std::streamoff>(header.data_offset));
+
+        auto out = std::ofstream{output, std::ios::binary | std::ios::trunc};
+        if (!out) return std::make_error_code(std::errc::io_error);
+        auto out_header = header;
+        out_header.count = 0;
+        out.write(reinterpret_cast<char const*>(&out_header), sizeof(out_header));
+        auto const padding = std::vector<char>(header.data_offset - sizeof(out_header), '\0');
+        out.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+
+        struct chunk {
+            std::vector<point> points;
+            std::size_t size;
+        };
+        auto free_chunks = detail::channel<chunk>{};
+        auto filled_chunks = detail::channel<chunk>{};
+        auto processed_chunks = detail::channel<chunk>{};
+        for (std::size_t i = 0; i < m_depth; ++i) {
+            free_chunks.push(chunk{std::vector<point>(m_chunk_size, point{vec_init::uninitialized}), 0});
+        }
+
+        auto stop = std::atomic<bool>{false};
+        auto read_error = std::error_code{};
+        auto write_error = std::error_code{};
+        auto stage_error = std::exception_ptr{};
+        std::uint64_t written = 0;
+        {
+            auto reader = std::jthread{[&] {
+                auto remaining = header.count;
+                while (remaining > 0 && !stop) {
+                    auto c = free_chunks.pop();
+                    if (!c) break;
+                    auto const n = static_cast<std::size_t>(std::min<std::uint64_t>(m_chunk_size, remaining));
+                    in.read(reinterpret_cast<char*>(c->points.data()), static_cast<std::streamsize>(n * sizeof(point)));
+                    if (!in) {
+                        read_error = std::make_error_code(std::errc::io_error);
+                        break;
+                    }
+                    c->size = n;
+                    remaining -= n;
+                    filled_chunks.push(std::move(*c));
+                }
+                filled_chunks.close();
+            }};
+
+            auto writer = std::jthread{[&] {
+                while (auto c = processed_chunks.pop()) {
+                    if (!write_error) {
+                        out.write(reinterpret_cast<char const*>(c->points.data()), static_cast<std::streamsize>(c->size * sizeof(point)));
+                        if (out) {
+                            written += c->size;
+                        } else {
+                            write_error = std::make_error_code(std::errc::io_error);
+                            stop = true;
+                        }
+                    }
+                    free_chunks.push(std::move(*c));
+                }
+            }};
+
+            try {
+                while (auto c = filled_chunks.pop()) {
+                    for (auto const& stage : m_stages) {
+                        c->size = stage(std::span<point>{c->points.data(), c->size});
+                        assert(c->size <= m_chunk_size);
+                    }
+                    processed_chunks.push(std::move(*c));
+                }
+            } catch (...) {
+                // Wake both threads wherever they wait so that they can be joined before rethrowing.
+                stage_error = std::current_exception();
+                stop = true;
+                free_chunks.close();
+                filled_chunks.close();
+            }
+            processed_chunks.close();
+        }
+
+        if (stage_error) std::rethrow_exception(stage_error);
+
+        if (read_error) return read_error;
+        if (write_error) return write_error;
+
+        out_header.count = written;
+        out.seekp(0);
+        out.write(reinterpret_cast<char const*>(&out_header), sizeof(out_header));
+        out.flush();
+        return out ? std::error_code{} : std::make_error_code(std::errc::io_error);
+    }
+
+    namespace detail {
+        template<typename T>
+        void channel<T>::push(T value)
+        {
+            {
+                auto const lock = std::lock_guard{m_mutex};
+                m_queue.push_back(std::move(value));
+            }
+            m_cv.notify_one();
+        }
+
+        template<typename T>
+        std::optional<T> channel<T>::pop()
+        {
+            auto lock = std::unique_lock{m_mutex};
+            m_cv.wait(lock, [this] { return !m_queue.empty() || m_closed; });
+            if (m_queue.empty()) return std::nullopt;
+            auto value = std::move(m_queue.front());
+            m_queue.pop_front();
+            return value;
+        }
+
+        template<typename T>
+        void channel<T>::close()
+        {
+            {
+                auto const lock = std::lock_guard{m_mutex};
+                m_closed = true;
+            }
+            m_cv.notify_all();
+        }
+    }
+}
+
+#endif // TINYLA_STREAM_INL
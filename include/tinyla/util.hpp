@@ -2,22 +2,295 @@
 #define TINYLA_UTIL_H
 
 #include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <concepts>
+#include <limits>
+#include <numbers>
 #include <numeric>
+#include <span>
+#include <type_traits>
 
 namespace tinyla
 {
+    /**
+    * abs, sqrt, sin, cos and tan forward to <cmath> at run time
+    * and fall back to portable implementations during constant evaluation.
+    */
+
+    template<std::floating_point T>
+    constexpr T abs(T x)
+    {
+        if (std::is_constant_evaluated()) {
+            return x < T{0} ? -x : x;
+        }
+        return std::abs(x);
+    }
+
+    template<std::floating_point T>
+    constexpr T sqrt(T x);
+
+    template<std::floating_point T>
+    constexpr T sin(T x);
+
+    template<std::floating_point T>
+    constexpr T cos(T x);
+
+    template<std::floating_point T>
+    constexpr T tan(T x);
+
+    template<typename T>
+    struct sincos_result {
+        T sin;
+        T cos;
+    };
+
+    // Sine and cosine of the same argument, which compilers fuse into a single sincos call.
+    template<std::floating_point T>
+    constexpr sincos_result<T> sincos(T x);
+
+    /**
+    * sines[i] and cosines[i] of x[i], by a branch-free polynomial kernel for float and double that
+    * vectorises; accurate to a few ulp for |x| up to about 1e5 (float) or 1e6 (double). Larger and non-finite
+    * arguments give meaningless but defined results.
+    */
+    template<std::floating_point T>
+    void sincos(std::span<const std::type_identity_t<T>> x, std::span<T> sines, std::span<T> cosines);
+
     template<std::floating_point T>
     constexpr bool close(T n1, T n2)
     {
-        return std::abs(n1 - n2) <= std::numeric_limits<T>::epsilon() * std::max(std::abs(n1), std::abs(n2));
+        return tinyla::abs(n1 - n2) <= std::numeric_limits<T>::epsilon() * std::max(tinyla::abs(n1), tinyla::abs(n2));
     }
 
     template<std::floating_point T>
     constexpr bool close_to_zero(T n)
     {
-        return std::abs(n) <= std::numeric_limits<T>::epsilon();
+        return tinyla::abs(n) <= std::numeric_limits<T>::epsilon();
+    }
+
+    namespace detail {
+        // Intermediate type for the constant-evaluated series, wide enough to round correctly to T.
+        template<std::floating_point T>
+        using wide_t = std::conditional_t<(sizeof(T) < sizeof(double)), double, T>;
+
+        template<std::floating_point T>
+        constexpr T sqrt_newton(T x)
+        {
+            if (!(x >= T{0})) return std::numeric_limits<T>::quiet_NaN();
+            if (x == T{0} || x == std::numeric_limits<T>::infinity()) return x;
+
+            // Newton's iteration converges from above; stop once it does not decrease any more.
+            auto r = x > T{1} ? x : T{1};
+            while (true) {
+                auto const next = (r + x / r) / T{2};
+                if (next >= r) return r;
+                r = next;
+            }
+        }
+
+        // sin(x) for x in [-pi/4, pi/4]
+        template<std::floating_point T>
+        constexpr T sin_series(T x)
+        {
+            auto const x2 = x * x;
+            auto term = x;
+            auto sum = x;
+            for (int i = 1; term != T{0}; ++i) {
+                term *= -x2 / static_cast<T>((2 * i) * (2 * i + 1));
+                auto const next = sum + term;
+                if (next == sum) break;
+                sum = next;
+            }
+            return sum;
+        }
+
+        // cos(x) for x in [-pi/4, pi/4]
+        template<std::floating_point T>
+        constexpr T cos_series(T x)
+        {
+            auto const x2 = x * x;
+            auto term = T{1};
+            auto sum = T{1};
+            for (int i = 1; term != T{0}; ++i) {
+                term *= -x2 / static_cast<T>((2 * i - 1) * (2 * i));
+                auto const next = sum + term;
+                if (next == sum) break;
+                sum = next;
+            }
+            return sum;
+        }
+
+        /**
+        * Reduces x to r in [-pi/4, pi/4] such that x = r + q * pi/2 and returns q modulo 4.
+        */
+        template<std::floating_point T>
+        constexpr int reduce_quarter_turns(T x, T& r)
+        {
+            constexpr auto half_pi = std::numbers::pi_v<T> / T{2};
+            auto const q = x / half_pi;
+            auto n = static_cast<long long>(q < T{0} ? q - T{0.5} : q + T{0.5});
+            auto const m = static_cast<T>(n);
+            if constexpr (std::is_same_v<T, long double>) {
+                // pi/2 in three 33-bit parts and a tail (the fdlibm constants, exact as double), so that the
+                // products with m are exact in the 64-bit significand of an extended long double for |n| < 2^31.
+                constexpr auto pio2_1 = T{1.57079632673412561417e+00};
+                constexpr auto pio2_2 = T{6.07710050630396597660e-11};
+                constexpr auto pio2_3 = T{2.02226624871116645580e-21};
+                constexpr auto pio2_3t = T{8.47842766036889956997e-32};
+                r = (((x - m * pio2_1) - m * pio2_2) - m * pio2_3) - m * pio2_3t;
+            } else {
+                // pi/2 in three parts of at most 24 bits and a tail (Cody-Waite), so that the products with m
+                // are exact in the 53-bit significand of a double for |n| < 2^29, that is |x| below about 8e8.
+                constexpr auto pio2_1 = T{1.570796251296997};
+                constexpr auto pio2_2 = T{7.549789415861596e-08};
+                constexpr auto pio2_3 = T{5.390302529957765e-15};
+                constexpr auto pio2_3t = T{3.2820035428735005e-22};
+                r = (((x - m * pio2_1) - m * pio2_2) - m * pio2_3) - m * pio2_3t;
+            }
+            return static_cast<int>(((n % 4) + 4) % 4);
+        }
+
+        template<std::floating_point T>
+        constexpr T sin_cos(T x, bool cosine)
+        {
+            using W = wide_t<T>;
+            if (x != x || x == std::numeric_limits<T>::infinity() || x == -std::numeric_limits<T>::infinity()) {
+                return std::numeric_limits<T>::quiet_NaN();
+            }
+            auto r = W{0};
+            auto q = reduce_quarter_turns(static_cast<W>(x), r);
+            if (cosine) q = (q + 1) % 4;
+            switch (q) {
+                case 0: return static_cast<T>(sin_series(r));
+                case 1: return static_cast<T>(cos_series(r));
+                case 2: return static_cast<T>(-sin_series(r));
+                default: return static_cast<T>(-cos_series(r));
+            }
+        }
+    }
+
+    template<std::floating_point T>
+    constexpr T sqrt(T x)
+    {
+        if (std::is_constant_evaluated()) {
+            return static_cast<T>(detail::sqrt_newton(static_cast<detail::wide_t<T>>(x)));
+        }
+        return std::sqrt(x);
+    }
+
+    template<std::floating_point T>
+    constexpr T sin(T x)
+    {
+        if (std::is_constant_evaluated()) {
+            return detail::sin_cos(x, false);
+        }
+        return std::sin(x);
+    }
+
+    template<std::floating_point T>
+    constexpr T cos(T x)
+    {
+        if (std::is_constant_evaluated()) {
+            return detail::sin_cos(x, true);
+        }
+        return std::cos(x);
+    }
+
+    template<std::floating_point T>
+    constexpr T tan(T x)
+    {
+        if (std::is_constant_evaluated()) {
+            return detail::sin_cos(x, false) / detail::sin_cos(x, true);
+        }
+        return std::tan(x);
+    }
+
+    template<std::floating_point T>
+    constexpr sincos_result<T> sincos(T x)
+    {
+        if (std::is_constant_evaluated()) {
+            return {detail::sin_cos(x, false), detail::sin_cos(x, true)};
+        }
+        return {std::sin(x), std::cos(x)};
+    }
+
+    namespace detail {
+        /**
+        * Cody-Waite reduction by pi/2 in three parts, Taylor polynomials on [-pi/4, pi/4]
+        * and a quadrant swap done with selects, so that a loop over it has no branches.
+        */
+        template<std::floating_point T>
+        inline sincos_result<T> sincos_kernel(T x)
+        {
+            constexpr bool is_float = std::is_same_v<T, float>;
+            constexpr T two_over_pi = std::numbers::inv_pi_v<T> * T{2};
+            // Adding and subtracting 1.5 * 2^(digits - 1) rounds to the nearest integer.
+            constexpr T round_magic = static_cast<T>(is_float ? 12582912.0 : 6755399441055744.0);
+            // pi/2 in parts whose products with k are exact for |k| < 2^16 (float: three 8-bit parts and a tail)
+            // or |k| < 2^20 (double: two 33-bit parts and a tail).
+            constexpr T pio2_1 = static_cast<T>(is_float ? 1.5703125 : 1.57079632673412561417e+00);
+            constexpr T pio2_2 = static_cast<T>(is_float ? 4.825592041015625e-4 : 6.07710050630396597660e-11);
+            constexpr T pio2_3 = static_cast<T>(is_float ? 1.2665987014770508e-6 : 2.02226624879595063154e-21);
+            constexpr T pio2_3t = static_cast<T>(is_float ? 9.92093629470503e-10 : 0.0);
+            // Bounds k before the conversion to an integer, which is undefined for NaN and out of range values.
+            constexpr T max_quarter_turns = static_cast<T>(1 << 30);
+            constexpr std::size_t terms = is_float ? 6 : 9;
+            // (-1)^i / (2i + 1)! and (-1)^i / (2i)!
+            constexpr auto coefficients = [] {
+                std::array<std::array<T, 2>, terms> a{};
+                T f = T{1};
+                for (std::size_t i = 0; i < terms; ++i) {
+                    if (i > 0) f *= static_cast<T>(2 * i - 1) * static_cast<T>(2 * i);
+                    T const sign = i % 2 == 0 ? T{1} : T{-1};
+                    a[i][1] = sign / f;
+                    a[i][0] = sign / (f * static_cast<T>(2 * i + 1));
+                }
+                return a;
+            }();
+
+            T const k = (x * two_over_pi + round_magic) - round_magic;
+            T r = ((x - k * pio2_1) - k * pio2_2) - k * pio2_3;
+            if constexpr (is_float) r -= k * pio2_3t;
+            T const r2 = r * r;
+
+            T sp = coefficients[terms - 1][0];
+            T cp = coefficients[terms - 1][1];
+            for (std::size_t i = terms - 1; i-- > 0;) {
+                sp = sp * r2 + coefficients[i][0];
+                cp = cp * r2 + coefficients[i][1];
+            }
+            sp *= r;
+
+            auto const q = static_cast<std::int32_t>(std::min(max_quarter_turns, std::max(-max_quarter_turns, k)));
+            bool const swap = (q & 1) != 0;
+            T const s = swap ? cp : sp;
+            T const c = swap ? sp : cp;
+            return {(q & 2) != 0 ? -s : s, ((q + 1) & 2) != 0 ? -c : c};
+        }
+    }
+
+    template<std::floating_point T>
+    void sincos(std::span<const std::type_identity_t<T>> x, std::span<T> sines, std::span<T> cosines)
+    {
+        assert(x.size() == sines.size() && x.size() == cosines.size());
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
+                auto const sc = detail::sincos_kernel(x[i]);
+                sines[i] = sc.sin;
+                cosines[i] = sc.cos;
+            } else {
+                sines[i] = std::sin(x[i]);
+                cosines[i] = std::cos(x[i]);
+            }
+        }
     }
 }
 
+// The fixed-point overloads of the functions above, visible wherever they are.
+#include <tinyla/fixed.hpp>
+
 #endif // TINYLA_UTIL_H
@@ -1,21 +1,19 @@
 #ifndef TINYLA_VEC_H
 #define TINYLA_VEC_H
 
+#include <tinyla/counters.hpp>
 #include <tinyla/util.hpp>
 #include <algorithm>
 #include <array>
 #include <cassert>
 #include <cmath>
-#include <functional>
 #include <initializer_list>
 #include <numeric>
+#include <type_traits>
+#include <utility>
 
 namespace tinyla
 {
-    template<std::size_t N, typename T>
-    requires(N >= 2)
-    class mat;
-
     enum class vec_init {
         uninitialized,
         zero
@@ -24,10 +22,16 @@ namespace tinyla
     template<typename T, typename... Types>
     concept is_all_same = (... && std::is_same_v<T, Types>);
 
+    template<typename V, std::size_t... I>
+    class vec_view;
+
     template<std::size_t N, typename T>
     requires(N >= 2)
     class vec {
     public:
+        using value_type = T;
+        static constexpr std::size_t size = N;
+
         constexpr explicit vec(vec_init init);
         constexpr vec(std::initializer_list<T> values);
 
@@ -38,6 +42,7 @@ namespace tinyla
         template<std::size_t M>
         constexpr vec(const vec<M, T>& smaller_vec, std::initializer_list<T> values) requires(M < N);
 
+        // Widening, e.g. vec4f{v3, 1.0f}; the count of extra components is checked at compile time.
         template<std::size_t M, typename...Ts>
         constexpr vec(const vec<M, T>& smaller_vec, Ts... vs) requires(M < N && sizeof...(Ts) == N - M);
 
@@ -86,14 +91,46 @@ namespace tinyla
         constexpr T& q() requires(N >= 4) { return v[3]; }
         constexpr T q() const requires(N >= 4) { return v[3]; }
 
+        /**
+        * Swizzles: the components I..., in that order, as a new vector, e.g. v.swizzle<2, 1, 0>().
+        * The indices are checked at compile time and the copy compiles down to register shuffles.
+        */
+        template<std::size_t... I>
+        constexpr vec<sizeof...(I), T> swizzle() const noexcept requires(sizeof...(I) >= 2 && ((I < N) && ...));
+
+        constexpr vec<2, T> xy() const noexcept { return swizzle<0, 1>(); }
+        constexpr vec<2, T> yx() const noexcept { return swizzle<1, 0>(); }
+        constexpr vec<2, T> xz() const noexcept requires(N >= 3) { return swizzle<0, 2>(); }
+        constexpr vec<2, T> yz() const noexcept requires(N >= 3) { return swizzle<1, 2>(); }
+        constexpr vec<3, T> xyz() const noexcept requires(N >= 3) { return swizzle<0, 1, 2>(); }
+        constexpr vec<3, T> zyx() const noexcept requires(N >= 3) { return swizzle<2, 1, 0>(); }
+        constexpr vec<3, T> rgb() const noexcept requires(N >= 3) { return swizzle<0, 1, 2>(); }
+
+        /**
+        * The components I... read and written in place, e.g. v.view<0, 1, 2>() = n or v.view<0, 2>() += d.
+        */
+        template<std::size_t... I>
+        constexpr vec_view<vec, I...> view() noexcept requires(sizeof...(I) >= 2 && ((I < N) && ...));
+
+        template<std::size_t... I>
+        constexpr vec_view<const vec, I...> view() const noexcept requires(sizeof...(I) >= 2 && ((I < N) && ...));
+
         constexpr T* data() noexcept { return v.data(); }
         constexpr const T* data() const noexcept { return v.data(); }
 
-        constexpr T length() const noexcept { return std::sqrt(dot(*this, *this)); }
+        // Integral vectors take the root in double and truncate, as std::sqrt did for them.
+        constexpr T length() const noexcept
+        {
+            if constexpr (std::integral<T>) {
+                return static_cast<T>(tinyla::sqrt(static_cast<double>(dot(*this, *this))));
+            } else {
+                return tinyla::sqrt(dot(*this, *this));
+            }
+        }
         constexpr T length_squared() const noexcept { return dot(*this, *this); }
 
-        vec normalized() const noexcept;
-        void normalize() noexcept;
+        constexpr vec normalized() const noexcept;
+        constexpr void normalize() noexcept;
 
         // Element-wise binary operations
 
@@ -103,15 +140,15 @@ namespace tinyla
         constexpr vec& operator-=(vec rhs) noexcept;
         constexpr friend vec operator- <>(vec vec1, vec vec2) noexcept;
 
-        constexpr vec& operator*=(float a) noexcept;
-        constexpr friend vec operator* <>(float a, vec vec) noexcept;
-        constexpr friend vec operator* <>(vec vec, float a) noexcept;
+        constexpr vec& operator*=(std::type_identity_t<T> a) noexcept;
+        constexpr friend vec operator* <>(std::type_identity_t<T> a, vec vec) noexcept;
+        constexpr friend vec operator* <>(vec vec, std::type_identity_t<T> a) noexcept;
 
         constexpr vec& operator*=(vec rhs) noexcept;
         constexpr friend vec operator* <>(vec vec1, vec vec2) noexcept;
 
-        constexpr vec& operator/=(float a) noexcept;
-        constexpr friend vec operator/ <>(vec vec, float a) noexcept;
+        constexpr vec& operator/=(std::type_identity_t<T> a) noexcept;
+        constexpr friend vec operator/ <>(vec vec, std::type_identity_t<T> a) noexcept;
 
         constexpr vec& operator/=(vec rhs) noexcept;
         constexpr friend vec operator/ <>(vec vec1, vec vec2) noexcept;
@@ -134,12 +171,51 @@ namespace tinyla
         */
         static constexpr vec normal(std::array<vec, 3> const& vs) noexcept requires(N == 3);
 
-        friend vec<N,T> operator* <>(const mat<N,T>& a, const vec<N,T>& b);
         friend constexpr T dot <>(vec<N, T> vec1, vec<N, T> vec2) noexcept;
     private:
         std::array<T, N> v;
     };
 
+    /**
+    * Reference to the components I... of a vector V (possibly const), behaving as a vec<sizeof...(I), T>.
+    * Writing through a view requires distinct indices. Copies of a view refer to the same vector.
+    */
+    template<typename V, std::size_t... I>
+    class vec_view {
+    public:
+        using value_type = typename std::remove_const_t<V>::value_type;
+        using vec_type = vec<sizeof...(I), value_type>;
+        static constexpr std::size_t size = sizeof...(I);
+
+        constexpr explicit vec_view(V& v) noexcept : m_v{v} {}
+        constexpr vec_view(vec_view const&) noexcept = default;
+
+        constexpr operator vec_type() const noexcept { return m_v.template swizzle<I...>(); }
+        constexpr vec_type get() const noexcept { return *this; }
+
+        constexpr decltype(auto) operator[](std::size_t i) const noexcept { return m_v[indices[i]]; }
+
+        constexpr vec_view const& operator=(vec_type const& rhs) const noexcept requires(!std::is_const_v<V>);
+        // Assigns the components, read before any is written, as with v.view<0, 1>() = v.view<1, 0>().
+        constexpr vec_view const& operator=(vec_view const& rhs) const noexcept requires(!std::is_const_v<V>);
+
+        constexpr vec_view const& operator+=(vec_type const& rhs) const noexcept requires(!std::is_const_v<V>);
+        constexpr vec_view const& operator-=(vec_type const& rhs) const noexcept requires(!std::is_const_v<V>);
+        constexpr vec_view const& operator*=(value_type a) const noexcept requires(!std::is_const_v<V>);
+    private:
+        static constexpr std::size_t indices[] = {I...};
+        static constexpr bool distinct = [] {
+            for (std::size_t i = 0; i < size; ++i) {
+                for (std::size_t j = i + 1; j < size; ++j) {
+                    if (indices[i] == indices[j]) return false;
+                }
+            }
+            return true;
+        }();
+
+        V& m_v;
+    };
+
     // deduction guide similar to std::array
     // https://en.cppreference.com/w/cpp/container/array/deduction_guides
     template<typename T, typename... U>
@@ -153,6 +229,10 @@ namespace tinyla
     using vec3f = vec<3, float>;
     using vec4f = vec<4, float>;
 
+    using vec2d = vec<2, double>;
+    using vec3d = vec<3, double>;
+    using vec4d = vec<4, double>;
+
     template<std::size_t N, typename T>
     requires(N >= 2)
     constexpr T dot(vec<N, T> vec1, vec<N, T> vec2) noexcept;
@@ -164,4 +244,36 @@ namespace tinyla
 
 #include "vec.inl"
 
+/**
+* Instantiates vec<N, T> and its free operators with the given declaration, either `template` for the definitions
+* compiled into the tinyla library or `extern template` for the declarations its users see.
+*/
+#define TINYLA_INSTANTIATE_VEC(declaration, N, T) \
+    declaration class tinyla::vec<N, T>; \
+    declaration T tinyla::dot(tinyla::vec<N, T>, tinyla::vec<N, T>) noexcept; \
+    declaration tinyla::vec<N, T> tinyla::operator+(tinyla::vec<N, T>, tinyla::vec<N, T>) noexcept; \
+    declaration tinyla::vec<N, T> tinyla::operator-(tinyla::vec<N, T>, tinyla::vec<N, T>) noexcept; \
+    declaration tinyla::vec<N, T> tinyla::operator*(T, tinyla::vec<N, T>) noexcept; \
+    declaration tinyla::vec<N, T> tinyla::operator*(tinyla::vec<N, T>, T) noexcept; \
+    declaration tinyla::vec<N, T> tinyla::operator*(tinyla::vec<N, T>, tinyla::vec<N, T>) noexcept; \
+    declaration tinyla::vec<N, T> tinyla::operator/(tinyla::vec<N, T>, T) noexcept; \
+    declaration tinyla::vec<N, T> tinyla::operator/(tinyla::vec<N, T>, tinyla::vec<N, T>) noexcept
+
+/**
+* The common aliases vec2f..vec4f and vec2d..vec4d.
+*/
+#define TINYLA_INSTANTIATE_VECS(declaration) \
+    TINYLA_INSTANTIATE_VEC(declaration, 2, float); \
+    TINYLA_INSTANTIATE_VEC(declaration, 3, float); \
+    TINYLA_INSTANTIATE_VEC(declaration, 4, float); \
+    TINYLA_INSTANTIATE_VEC(declaration, 2, double); \
+    TINYLA_INSTANTIATE_VEC(declaration, 3, double); \
+    TINYLA_INSTANTIATE_VEC(declaration, 4, double); \
+    declaration tinyla::vec<3, float> tinyla::cross(tinyla::vec<3, float>, tinyla::vec<3, float>) noexcept; \
+    declaration tinyla::vec<3, double> tinyla::cross(tinyla::vec<3, double>, tinyla::vec<3, double>) noexcept
+
+#ifdef TINYLA_EXTERN_TEMPLATES
+TINYLA_INSTANTIATE_VECS(extern template);
+#endif
+
 #endif // TINYLA_VEC_H
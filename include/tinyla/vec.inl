@@ -6,9 +6,9 @@
 #include <array>
 #include <cassert>
 #include <cmath>
-#include <functional>
 #include <initializer_list>
 #include <numeric>
+#include <utility>
 
 namespace tinyla
 {
@@ -49,7 +49,9 @@ namespace tinyla
     requires(N >= 2)
     template<std::size_t M, typename...Ts>
     constexpr vec<N, T>::vec(const vec<M, T>& smaller_vec, Ts... vs) requires(M < N && sizeof...(Ts) == N - M)
-        : vec(smaller_vec, std::initializer_list<T>{ vs... })
+        : v{[&]<std::size_t... I>(std::index_sequence<I...>) {
+              return std::array<T, N>{smaller_vec[I]..., vs...};
+          }(std::make_index_sequence<M>{})}
     {}
 
     template<std::size_t N, typename T>
@@ -63,28 +65,97 @@ namespace tinyla
     requires(N >= 2)
     constexpr void vec<N, T>::fill(const T& value) { v.fill(value); }
 
+    template<std::size_t N, typename T>
+    requires(N >= 2)
+    template<std::size_t... I>
+    constexpr vec<sizeof...(I), T> vec<N, T>::swizzle() const noexcept requires(sizeof...(I) >= 2 && ((I < N) && ...))
+    {
+        return vec<sizeof...(I), T>(v[I]...);
+    }
+
+    template<std::size_t N, typename T>
+    requires(N >= 2)
+    template<std::size_t... I>
+    constexpr vec_view<vec<N, T>, I...> vec<N, T>::view() noexcept requires(sizeof...(I) >= 2 && ((I < N) && ...))
+    {
+        return vec_view<vec, I...>{*this};
+    }
+
+    template<std::size_t N, typename T>
+    requires(N >= 2)
+    template<std::size_t... I>
+    constexpr vec_view<const vec<N, T>, I...> vec<N, T>::view() const noexcept requires(sizeof...(I) >= 2 && ((I < N) && ...))
+    {
+        return vec_view<const vec, I...>{*this};
+    }
+
+    template<typename V, std::size_t... I>
+    constexpr vec_view<V, I...> const& vec_view<V, I...>::operator=(vec_type const& rhs) const noexcept
+        requires(!std::is_const_v<V>)
+    {
+        static_assert(distinct, "cannot write through a view with repeated components");
+        for (std::size_t i = 0; i < size; ++i) m_v[indices[i]] = rhs[i];
+        return *this;
+    }
+
+    template<typename V, std::size_t... I>
+    constexpr vec_view<V, I...> const& vec_view<V, I...>::operator=(vec_view const& rhs) const noexcept
+        requires(!std::is_const_v<V>)
+    {
+        return *this = rhs.get();
+    }
+
+    template<typename V, std::size_t... I>
+    constexpr vec_view<V, I...> const& vec_view<V, I...>::operator+=(vec_type const& rhs) const noexcept
+        requires(!std::is_const_v<V>)
+    {
+        static_assert(distinct, "cannot write through a view with repeated components");
+        for (std::size_t i = 0; i < size; ++i) m_v[indices[i]] += rhs[i];
+        return *this;
+    }
+
+    template<typename V, std::size_t... I>
+    constexpr vec_view<V, I...> const& vec_view<V, I...>::operator-=(vec_type const& rhs) const noexcept
+        requires(!std::is_const_v<V>)
+    {
+        static_assert(distinct, "cannot write through a view with repeated components");
+        for (std::size_t i = 0; i < size; ++i) m_v[indices[i]] -= rhs[i];
+        return *this;
+    }
+
+    template<typename V, std::size_t... I>
+    constexpr vec_view<V, I...> const& vec_view<V, I...>::operator*=(value_type a) const noexcept
+        requires(!std::is_const_v<V>)
+    {
+        static_assert(distinct, "cannot write through a view with repeated components");
+        for (std::size_t i = 0; i < size; ++i) m_v[indices[i]] *= a;
+        return *this;
+    }
+
     template<std::size_t N, typename T>
     requires (N >= 2)
-    tinyla::vec<N, T> tinyla::vec<N, T>::normalized() const noexcept
+    constexpr tinyla::vec<N, T> tinyla::vec<N, T>::normalized() const noexcept
     {
-        const float len = length();
-        if (close_to_zero(len - 1.0f) || close_to_zero(len)) return *this;
+        TINYLA_COUNT(normalized, T);
+        const T len = length();
+        if (close_to_zero(len - T{1}) || close_to_zero(len)) return *this;
         return *this / len;
     }
 
     template<std::size_t N, typename T>
     requires (N >= 2)
-    void tinyla::vec<N, T>::normalize() noexcept
+    constexpr void tinyla::vec<N, T>::normalize() noexcept
     {
-        const float len = length();
-        if (!close_to_zero(len - 1.0f) && !close_to_zero(len)) *this /= len;
+        TINYLA_COUNT(normalize, T);
+        const T len = length();
+        if (!close_to_zero(len - T{1}) && !close_to_zero(len)) *this /= len;
     }
 
     template<std::size_t N, typename T>
     requires (N >= 2)
     constexpr vec<N, T>& vec<N, T>::operator+=(vec<N, T> rhs) noexcept
     {
-        std::transform(v.begin(), v.end(), rhs.v.begin(), v.begin(), std::plus<T>());
+        std::transform(v.begin(), v.end(), rhs.v.begin(), v.begin(), [](T a, T b) { return a + b; });
         return *this;
     }
 
@@ -100,7 +171,7 @@ namespace tinyla
     requires (N >= 2)
     constexpr vec<N, T>& vec<N, T>::operator-=(vec<N, T> rhs) noexcept
     {
-        std::transform(v.begin(), v.end(), rhs.v.begin(), v.begin(), std::minus<T>());
+        std::transform(v.begin(), v.end(), rhs.v.begin(), v.begin(), [](T a, T b) { return a - b; });
         return *this;
     }
 
@@ -114,7 +185,7 @@ namespace tinyla
 
     template<std::size_t N, typename T>
     requires (N >= 2)
-    constexpr vec<N, T>& vec<N, T>::operator*=(float a) noexcept
+    constexpr vec<N, T>& vec<N, T>::operator*=(std::type_identity_t<T> a) noexcept
     {
         std::transform(v.begin(), v.end(), v.begin(), [a](auto& c) { return a * c; });
         return *this;
@@ -122,7 +193,7 @@ namespace tinyla
 
     template<std::size_t N, typename T>
     requires (N >= 2)
-    constexpr vec<N, T> operator*(float a, vec<N, T> vec) noexcept
+    constexpr vec<N, T> operator*(std::type_identity_t<T> a, vec<N, T> vec) noexcept
     {
         vec *= a;
         return vec;
@@ -130,7 +201,7 @@ namespace tinyla
 
     template<std::size_t N, typename T>
     requires (N >= 2)
-    constexpr vec<N, T> operator*(vec<N, T> vec, float a) noexcept
+    constexpr vec<N, T> operator*(vec<N, T> vec, std::type_identity_t<T> a) noexcept
     {
         vec *= a;
         return vec;
@@ -140,7 +211,7 @@ namespace tinyla
     requires (N >= 2)
     constexpr vec<N, T>& vec<N, T>::operator*=(vec<N, T> rhs) noexcept
     {
-        std::transform(v.begin(), v.end(), rhs.v.begin(), v.begin(), std::multiplies<T>());
+        std::transform(v.begin(), v.end(), rhs.v.begin(), v.begin(), [](T a, T b) { return a * b; });
         return *this;
     }
 
@@ -154,7 +225,7 @@ namespace tinyla
 
     template<std::size_t N, typename T>
     requires (N >= 2)
-    constexpr vec<N, T>& vec<N, T>::operator/=(float a) noexcept
+    constexpr vec<N, T>& vec<N, T>::operator/=(std::type_identity_t<T> a) noexcept
     {
         std::transform(v.begin(), v.end(), v.begin(), [a](auto& c) { return c / a; });
         return *this;
@@ -162,7 +233,7 @@ namespace tinyla
 
     template<std::size_t N, typename T>
     requires (N >= 2)
-    constexpr vec<N, T> operator/(vec<N, T> vec, float a) noexcept
+    constexpr vec<N, T> operator/(vec<N, T> vec, std::type_identity_t<T> a) noexcept
     {
         vec /= a;
         return vec;
@@ -172,7 +243,7 @@ namespace tinyla
     requires (N >= 2)
     constexpr vec<N, T>& vec<N, T>::operator/=(vec<N, T> rhs) noexcept
     {
-        std::transform(v.begin(), v.end(), rhs.v.begin(), v.begin(), std::divides<T>());
+        std::transform(v.begin(), v.end(), rhs.v.begin(), v.begin(), [](T a, T b) { return a / b; });
         return *this;
     }
 
@@ -189,7 +260,7 @@ namespace tinyla
     constexpr vec<N, T> vec<N, T>::operator-() noexcept
     {
         auto result = tinyla::vec<N,T>{vec_init::uninitialized};
-        std::transform(v.begin(), v.end(), result.v.begin(), std::negate<T>());
+        std::transform(v.begin(), v.end(), result.v.begin(), [](T c) { return -c; });
         return result;
     }
 
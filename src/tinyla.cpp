@@ -0,0 +1,6 @@
+// The explicit instantiations that the tinyla headers declare extern when TINYLA_EXTERN_TEMPLATES is defined.
+#include <tinyla/mat.hpp>
+#include <tinyla/vec.hpp>
+
+TINYLA_INSTANTIATE_VECS(template);
+TINYLA_INSTANTIATE_MATS(template);
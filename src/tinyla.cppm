@@ -0,0 +1,137 @@
+/**
+* Module interface of the core of tinyla: scalars, vectors, matrices, their batched forms and the geometry helpers.
+* The headers stay the primary interface; `import tinyla;` only exports the names below, built on top of them.
+*/
+module;
+
+#include <tinyla/batch.hpp>
+#include <tinyla/fixed.hpp>
+#include <tinyla/geom.hpp>
+#include <tinyla/mat.hpp>
+#include <tinyla/parallel.hpp>
+#include <tinyla/soa.hpp>
+#include <tinyla/util.hpp>
+#include <tinyla/vec.hpp>
+
+export module tinyla;
+
+export namespace tinyla {
+    // util.hpp
+    using tinyla::abs;
+    using tinyla::sqrt;
+    using tinyla::sin;
+    using tinyla::cos;
+    using tinyla::tan;
+    using tinyla::sincos;
+    using tinyla::sincos_result;
+    using tinyla::close;
+    using tinyla::close_to_zero;
+
+    // fixed.hpp
+    using tinyla::fixed;
+    using tinyla::q16_16;
+#ifdef __SIZEOF_INT128__
+    using tinyla::q32_32;
+#endif
+    using tinyla::multiply_add;
+    using tinyla::dot_soa;
+
+    // vec.hpp
+    using tinyla::vec_init;
+    using tinyla::vec;
+    using tinyla::vec_view;
+    using tinyla::vec2i;
+    using tinyla::vec3i;
+    using tinyla::vec4i;
+    using tinyla::vec2f;
+    using tinyla::vec3f;
+    using tinyla::vec4f;
+    using tinyla::vec2d;
+    using tinyla::vec3d;
+    using tinyla::vec4d;
+    using tinyla::dot;
+    using tinyla::cross;
+    using tinyla::operator+;
+    using tinyla::operator-;
+    using tinyla::operator*;
+    using tinyla::operator/;
+
+    // mat.hpp
+    using tinyla::mat_init;
+    using tinyla::matrix;
+    using tinyla::mat;
+    using tinyla::mat2i;
+    using tinyla::mat3i;
+    using tinyla::mat4i;
+    using tinyla::mat2f;
+    using tinyla::mat3f;
+    using tinyla::mat4f;
+    using tinyla::mat2d;
+    using tinyla::mat3d;
+    using tinyla::mat4d;
+    using tinyla::mat2x3f;
+    using tinyla::mat2x3d;
+    using tinyla::mat3x4f;
+    using tinyla::mat3x4d;
+    using tinyla::mat4x3f;
+    using tinyla::mat4x3d;
+
+    // batch.hpp
+    using tinyla::store_hint;
+    using tinyla::multiply;
+    using tinyla::transform_points;
+    using tinyla::project_points;
+
+    // soa.hpp
+    using tinyla::default_lanes;
+    using tinyla::mat4_pack;
+    using tinyla::vec_pack;
+    using tinyla::vec_pack_view;
+    using tinyla::pack_count;
+    using tinyla::to_soa;
+    using tinyla::from_soa;
+    using tinyla::determinant;
+    using tinyla::invert;
+}
+
+export namespace tinyla::parallel {
+    using tinyla::parallel::options;
+}
+
+export namespace tinyla::geom {
+    using tinyla::geom::angle;
+    using tinyla::geom::cached_angle;
+    using tinyla::geom::sincos;
+    using tinyla::geom::handedness;
+    using tinyla::geom::clip_volume;
+    using tinyla::geom::decomposition;
+    using tinyla::geom::frustum;
+    using tinyla::geom::view_box;
+    using tinyla::geom::transform_pair;
+    using tinyla::geom::trs;
+    using tinyla::geom::perspective;
+    using tinyla::geom::orthographic;
+    using tinyla::geom::look_at;
+    using tinyla::geom::project;
+    using tinyla::geom::scaling;
+    using tinyla::geom::translation;
+    using tinyla::geom::rotation;
+    using tinyla::geom::pre_rotate;
+    using tinyla::geom::post_rotate;
+    using tinyla::geom::pre_translate;
+    using tinyla::geom::post_translate;
+    using tinyla::geom::pre_scale;
+    using tinyla::geom::post_scale;
+    using tinyla::geom::decompose;
+    using tinyla::geom::compose;
+    using tinyla::geom::camera_relative;
+}
+
+export namespace tinyla::geom::literals {
+    using tinyla::geom::literals::operator""_radf;
+    using tinyla::geom::literals::operator""_degf;
+    using tinyla::geom::literals::operator""_radd;
+    using tinyla::geom::literals::operator""_degd;
+    using tinyla::geom::literals::operator""_radld;
+    using tinyla::geom::literals::operator""_degld;
+}
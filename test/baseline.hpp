@@ -0,0 +1,181 @@
+#ifndef TINYLA_TEST_BASELINE_HPP
+#define TINYLA_TEST_BASELINE_HPP
+
+#include "perf_counters.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+* Benchmark timings recorded to a baseline file and compared against it in a later run.
+* A kernel regressed when its samples are significantly slower than its baseline samples slowed down by the
+* tolerance, by a one-sided Mann-Whitney U test. Both runs should come from the same machine, idle and with the
+* same build.
+*/
+namespace baseline {
+    // Nanoseconds per call of one kernel, one value per sample.
+    using samples = std::vector<double>;
+
+    // Samples of every kernel by name.
+    using results = std::map<std::string, samples>;
+
+    /**
+    * count samples of f, each the mean time of perf::calls_taking(f, sample_time) consecutive calls.
+    */
+    template<typename F>
+    samples sample(F&& f, std::size_t count,
+                   std::chrono::nanoseconds sample_time = std::chrono::milliseconds{5});
+
+    /**
+    * Writes one line per kernel, its name and its samples separated by tabs, after a comment line.
+    */
+    bool write(std::filesystem::path const& path, results const& results);
+
+    std::optional<results> read(std::filesystem::path const& path);
+
+    /**
+    * Probability of samples at least as much greater than the baseline as current are, were they drawn from the
+    * same distribution: the one-sided p-value of the Mann-Whitney U test, in the normal approximation with tie
+    * correction, which is adequate from around ten samples each.
+    */
+    double p_greater(samples const& current, samples const& baseline);
+
+    double median(samples samples);
+
+    /**
+    * Prints every kernel of current with its median change against the baseline and returns the number of
+    * regressions, kernels for which p_greater(current, baseline * (1 + tolerance)) < alpha.
+    * Kernels missing from either side are listed but never regress.
+    */
+    std::size_t compare(results const& baseline, results const& current, double tolerance, double alpha);
+
+    template<typename F>
+    samples sample(F&& f, std::size_t count, std::chrono::nanoseconds sample_time)
+    {
+        using clock = std::chrono::steady_clock;
+
+        auto const calls = perf::calls_taking(f, sample_time);
+        auto result = samples(count);
+        for (auto& s : result) {
+            auto const start = clock::now();
+            for (std::size_t i = 0; i < calls; ++i) f();
+            auto const elapsed = std::chrono::duration<double, std::nano>{clock::now() - start};
+            s = elapsed.count() / static_cast<double>(calls);
+        }
+        return result;
+    }
+
+    inline bool write(std::filesystem::path const& path, results const& results)
+    {
+        auto file = std::ofstream{path};
+        file << "# tinyla benchmark baseline: kernel, then nanoseconds per call of every sample\n";
+        file.precision(9);
+        for (auto const& [name, samples] : results) {
+            file << name;
+            for (auto const s : samples) file << '\t' << s;
+            file << '\n';
+        }
+        return static_cast<bool>(file);
+    }
+
+    inline std::optional<results> read(std::filesystem::path const& path)
+    {
+        auto file = std::ifstream{path};
+        if (!file) return std::nullopt;
+
+        auto result = results{};
+        for (auto line = std::string{}; std::getline(file, line);) {
+            if (line.empty() || line.front() == '#') continue;
+            auto fields = std::istringstream{line};
+            auto name = std::string{};
+            std::getline(fields, name, '\t');
+            auto& samples = result[name];
+            for (auto field = std::string{}; std::getline(fields, field, '\t');) samples.push_back(std::stod(field));
+            if (samples.empty()) return std::nullopt;
+        }
+        return result;
+    }
+
+    inline double p_greater(samples const& current, samples const& baseline)
+    {
+        auto const n1 = static_cast<double>(current.size());
+        auto const n2 = static_cast<double>(baseline.size());
+
+        // (value, from current) in ascending order, ranked from 1 with ties sharing their mean rank
+        auto all = std::vector<std::pair<double, bool>>{};
+        for (auto const s : current) all.emplace_back(s, true);
+        for (auto const s : baseline) all.emplace_back(s, false);
+        std::ranges::sort(all);
+
+        auto rank_sum = 0.0;
+        auto ties = 0.0;
+        for (std::size_t first = 0; first < all.size();) {
+            auto last = first + 1;
+            while (last < all.size() && all[last].first == all[first].first) ++last;
+            auto const rank = static_cast<double>(first + last + 1) / 2.0;
+            for (auto i = first; i < last; ++i) {
+                if (all[i].second) rank_sum += rank;
+            }
+            auto const t = static_cast<double>(last - first);
+            ties += t * t * t - t;
+            first = last;
+        }
+
+        auto const n = n1 + n2;
+        auto const u = rank_sum - n1 * (n1 + 1.0) / 2.0;
+        auto const variance = n1 * n2 / 12.0 * ((n + 1.0) - ties / (n * (n - 1.0)));
+        if (variance <= 0.0) return 1.0;
+        auto const z = (u - n1 * n2 / 2.0 - 0.5) / std::sqrt(variance);
+        return 0.5 * std::erfc(z / std::sqrt(2.0));
+    }
+
+    inline double median(samples samples)
+    {
+        auto const middle = samples.begin() + static_cast<std::ptrdiff_t>(samples.size() / 2);
+        std::ranges::nth_element(samples, middle);
+        if (samples.size() % 2 != 0) return *middle;
+        return (*middle + *std::ranges::max_element(samples.begin(), middle)) / 2.0;
+    }
+
+    inline std::size_t compare(results const& baseline, results const& current, double tolerance, double alpha)
+    {
+        std::printf("\n%-48s %12s %12s %9s %9s\n", "kernel", "baseline ns", "current ns", "change", "p");
+        auto regressions = std::size_t{0};
+        for (auto const& [name, samples] : current) {
+            auto const it = baseline.find(name);
+            if (it == baseline.end()) {
+                std::printf("%-48s %12s %12.2f %9s %9s  new\n", name.c_str(), "-", median(samples), "-", "-");
+                continue;
+            }
+
+            auto tolerated = it->second;
+            for (auto& s : tolerated) s *= 1.0 + tolerance;
+            auto const p = p_greater(samples, tolerated);
+            auto const before = median(it->second);
+            auto const after = median(samples);
+            auto const regressed = p < alpha;
+            regressions += regressed;
+            std::printf("%-48s %12.2f %12.2f %+8.1f%% %9.2g%s\n", name.c_str(), before, after,
+                        100.0 * (after - before) / before, p, regressed ? "  REGRESSION" : "");
+        }
+        for (auto const& [name, samples] : baseline) {
+            if (!current.contains(name)) {
+                std::printf("%-48s %12.2f %12s %9s %9s  not run\n", name.c_str(), median(samples), "-", "-", "-");
+            }
+        }
+        std::printf("\n%zu of %zu kernels regressed by more than %g%% (alpha %g)\n",
+                    regressions, current.size(), 100.0 * tolerance, alpha);
+        return regressions;
+    }
+}
+
+#endif // TINYLA_TEST_BASELINE_HPP
@@ -0,0 +1,87 @@
+#include <tinyla/batch.hpp>
+#include <tinyla/geom.hpp>
+#include <tinyla/mat.hpp>
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch_all.hpp>
+#include "compare.hpp"
+#include "data.hpp"
+#include <vector>
+
+static std::vector<tinyla::mat4f> make_matrices(std::size_t count)
+{
+    auto ms = std::vector<tinyla::mat4f>{};
+    for (std::size_t i = 0; i < count; ++i) {
+        auto m = tinyla::geom::translation(tinyla::vec3f{float(i), 2.0f, -float(i)});
+        tinyla::geom::post_rotate(m, tinyla::geom::angle<float>::from_degrees(10.0f * float(i)), tinyla::vec3f{1.0f, 1.0f, 0.0f});
+        tinyla::geom::post_scale(m, tinyla::vec3f{1.0f, 2.0f, 0.5f});
+        ms.push_back(m);
+    }
+    return ms;
+}
+
+TEST_CASE("mat4 batched multiply with constant lhs", "[mat4]")
+{
+    auto const rhs = make_matrices(17);
+    for (auto hint : {tinyla::store_hint::automatic, tinyla::store_hint::cached, tinyla::store_hint::streaming}) {
+        auto out = std::vector<tinyla::mat4f>(rhs.size(), zero);
+        tinyla::multiply(unique, rhs, out, hint);
+        for (std::size_t i = 0; i < rhs.size(); ++i) {
+            CAPTURE(i);
+            compare(out[i], unique * rhs[i]);
+        }
+    }
+}
+
+TEST_CASE("mat4 batched multiply with constant rhs", "[mat4]")
+{
+    auto const lhs = make_matrices(17);
+    for (auto hint : {tinyla::store_hint::automatic, tinyla::store_hint::cached, tinyla::store_hint::streaming}) {
+        auto out = std::vector<tinyla::mat4f>(lhs.size(), zero);
+        tinyla::multiply(lhs, unique, out, hint);
+        for (std::size_t i = 0; i < lhs.size(); ++i) {
+            CAPTURE(i);
+            compare(out[i], lhs[i] * unique);
+        }
+    }
+}
+
+TEST_CASE("mat4 batched multiply in place", "[mat4]")
+{
+    auto const expected = make_matrices(5);
+    auto ms = expected;
+    tinyla::multiply(std::span<const tinyla::mat4f>{ms}, identity, ms);
+    tinyla::multiply(identity, std::span<const tinyla::mat4f>{ms}, ms);
+    for (std::size_t i = 0; i < ms.size(); ++i) {
+        CAPTURE(i);
+        compare(ms[i], expected[i]);
+    }
+}
+
+TEST_CASE("vec3 batched transform_points and project_points", "[vec3]")
+{
+    auto const m = make_matrices(3)[2];
+    auto points = std::vector<tinyla::vec3f>{};
+    for (std::size_t i = 0; i < 9; ++i) points.emplace_back(float(i), -float(i), 2.0f);
+
+    auto out = points;
+    tinyla::transform_points(m, points, out);
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        CAPTURE(i);
+        auto const v = m * tinyla::vec4f{points[i], 1.0f};
+        compare(out[i], tinyla::vec3f{v.x(), v.y(), v.z()});
+    }
+
+    auto p = unique;
+    out = points;
+    tinyla::project_points(p, std::span<const tinyla::vec3f>{out}, out);
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        CAPTURE(i);
+        auto const v = tinyla::geom::project(p, tinyla::vec4f{points[i], 1.0f});
+        compare(out[i], tinyla::vec3f{v.x(), v.y(), v.z()});
+    }
+}
+
+int main(int argc, const char* argv[])
+{
+    return Catch::Session().run(argc, argv);
+}
@@ -36,6 +36,16 @@ void compare(const tinyla::vec<N,T>& tgl_vec, const std::array<T,N>& glm_vec)
     }
 }
 
+template<std::size_t N, typename T>
+requires(std::is_floating_point_v<T>)
+void compare(const tinyla::vec<N,T>& tgl_vec, const std::array<T,N>& glm_vec, T margin)
+{
+    for (std::size_t i = 0; i < N; ++i) {
+        CAPTURE(i);
+        REQUIRE(tgl_vec[i] == Catch::Approx(glm_vec[i]).margin(margin));
+    }
+}
+
 template<std::size_t N, typename T>
 void compare(const tinyla::mat<N,T>& m, const std::array<std::array<T,N>,N>& a)
 {
@@ -48,14 +58,38 @@ void compare(const tinyla::mat<N,T>& m, const std::array<std::array<T,N>,N>& a)
     }
 }
 
+template<std::size_t R, std::size_t C, typename T>
+void compare(const tinyla::matrix<R,C,T>& m1, const tinyla::matrix<R,C,T>& m2)
+{
+    for (std::size_t i = 0; i < R; ++i) {
+        for (std::size_t j = 0; j < C; ++j) {
+            CAPTURE(i);
+            CAPTURE(j);
+            REQUIRE(m1[i, j] == Catch::Approx(m2[i, j]));
+        }
+    }
+}
+
 template<std::size_t N, typename T>
-void compare(const tinyla::mat<N,T>& m1, const tinyla::mat<N,T>& m2)
+void compare(const tinyla::mat<N,T>& m, const std::array<std::array<T,N>,N>& a, T margin)
 {
     for (std::size_t i = 0; i < N; ++i) {
         for (std::size_t j = 0; j < N; ++j) {
             CAPTURE(i);
             CAPTURE(j);
-            REQUIRE(m1[i, j] == Catch::Approx(m2[i, j]));
+            REQUIRE(m[i, j] == Catch::Approx(a[i][j]).margin(margin));
+        }
+    }
+}
+
+template<std::size_t R, std::size_t C, typename T>
+void compare(const tinyla::matrix<R,C,T>& m1, const tinyla::matrix<R,C,T>& m2, T margin)
+{
+    for (std::size_t i = 0; i < R; ++i) {
+        for (std::size_t j = 0; j < C; ++j) {
+            CAPTURE(i);
+            CAPTURE(j);
+            REQUIRE(m1[i, j] == Catch::Approx(m2[i, j]).margin(margin));
         }
     }
 }
@@ -0,0 +1,104 @@
+#include <tinyla/batch.hpp>
+#include <tinyla/counters.hpp>
+#include <tinyla/geom.hpp>
+#include <tinyla/mat.hpp>
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch_all.hpp>
+#include "data.hpp"
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace tinyla::geom::literals;
+using tinyla::counters::op;
+using tinyla::counters::scalar;
+
+TEST_CASE("counters count calls per operation and scalar type", "[counters]")
+{
+    tinyla::counters::reset();
+
+    auto m = unique * identity;
+    m = m.inverted();
+    [[maybe_unused]] auto const d = tinyla::mat4d{tinyla::mat_init::identity}.determinant();
+    [[maybe_unused]] auto const v = m * tinyla::vec4f{1.0f, 2.0f, 3.0f, 4.0f};
+    tinyla::vec3d{1.0, 2.0, 3.0}.normalize();
+
+    auto const snapshot = tinyla::counters::take_snapshot();
+    REQUIRE(snapshot[op::mat_mul_mat, scalar::float_] == 1);
+    REQUIRE(snapshot[op::inverted, scalar::float_] == 1);
+    REQUIRE(snapshot[op::determinant, scalar::double_] == 1);
+    REQUIRE(snapshot[op::mat_mul_vec, scalar::float_] == 1);
+    REQUIRE(snapshot[op::normalize, scalar::double_] == 1);
+    REQUIRE(snapshot.total(op::normalized) == 0);
+}
+
+TEST_CASE("counters record the pre_rotate and post_rotate branches", "[counters]")
+{
+    tinyla::counters::reset();
+
+    auto m = unique;
+    tinyla::geom::pre_rotate(m, 45.0_degf, {1.0f, 0.0f, 0.0f});
+    tinyla::geom::pre_rotate(m, 45.0_degf, {0.0f, 0.0f, 1.0f});
+    tinyla::geom::pre_rotate(m, 45.0_degf, {1.0f, 1.0f, 0.0f});
+    tinyla::geom::post_rotate(m, 45.0_degf, {0.0f, 1.0f, 0.0f});
+    tinyla::geom::post_rotate(m, 45.0_degf, {0.0f, 1.0f, 1.0f});
+
+    auto const snapshot = tinyla::counters::take_snapshot();
+    REQUIRE(snapshot[op::pre_rotate_x, scalar::float_] == 1);
+    REQUIRE(snapshot[op::pre_rotate_y, scalar::float_] == 0);
+    REQUIRE(snapshot[op::pre_rotate_z, scalar::float_] == 1);
+    REQUIRE(snapshot[op::pre_rotate_axis, scalar::float_] == 1);
+    REQUIRE(snapshot[op::post_rotate_y, scalar::float_] == 1);
+    REQUIRE(snapshot[op::post_rotate_axis, scalar::float_] == 1);
+    // Each fallback multiplies by a full rotation matrix.
+    REQUIRE(snapshot[op::mat_mul_mat, scalar::float_] == 2);
+}
+
+TEST_CASE("counters count batched matrices", "[counters]")
+{
+    tinyla::counters::reset();
+    auto ms = std::vector<tinyla::mat4f>(10, unique);
+    tinyla::multiply(identity, std::span<const tinyla::mat4f>{ms}, ms);
+    REQUIRE(tinyla::counters::take_snapshot()[op::mat_mul_mat_batched, scalar::float_] == 10);
+}
+
+TEST_CASE("counters are per thread", "[counters]")
+{
+    tinyla::counters::reset();
+    auto const before = tinyla::counters::take_snapshot();
+
+    auto other = tinyla::counters::snapshot{};
+    std::thread{[&other] {
+        [[maybe_unused]] auto const m = unique * unique;
+        other = tinyla::counters::take_snapshot();
+    }}.join();
+    [[maybe_unused]] auto const m = unique * unique * unique;
+
+    REQUIRE(other[op::mat_mul_mat, scalar::float_] == 1);
+    auto const delta = tinyla::counters::take_snapshot() - before;
+    REQUIRE(delta[op::mat_mul_mat, scalar::float_] == 2);
+}
+
+TEST_CASE("counters dump", "[counters]")
+{
+    tinyla::counters::reset();
+    [[maybe_unused]] auto const m = tinyla::mat4i{tinyla::mat_init::identity} * tinyla::mat4i{tinyla::mat_init::identity};
+    tinyla::vec2f{3.0f, 4.0f}.normalized();
+
+    auto os = std::ostringstream{};
+    tinyla::counters::dump(os, tinyla::counters::take_snapshot());
+    REQUIRE(os.str() == "mat_mul_mat int 1\nnormalized float 1\n");
+}
+
+TEST_CASE("counters are not touched by constant evaluation", "[counters]")
+{
+    tinyla::counters::reset();
+    constexpr auto m = tinyla::mat4f{tinyla::mat_init::identity} * tinyla::mat4f{tinyla::mat_init::identity};
+    REQUIRE(m[0, 0] == 1.0f);
+    REQUIRE(tinyla::counters::take_snapshot().total(op::mat_mul_mat) == 0);
+}
+
+int main(int argc, const char* argv[])
+{
+    return Catch::Session().run(argc, argv);
+}
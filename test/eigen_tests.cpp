@@ -0,0 +1,114 @@
+#include <tinyla/eigen.hpp>
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch_all.hpp>
+#include "compare.hpp"
+#include <cstdint>
+#include <vector>
+
+template<typename T>
+static std::vector<tinyla::mat<3,T>> make_matrices(std::size_t count, std::uint64_t seed)
+{
+    auto matrices = std::vector<tinyla::mat<3,T>>(count, tinyla::mat<3,T>{tinyla::mat_init::zero});
+    for (auto& m : matrices) {
+        for (std::size_t k = 0; k < 9; ++k) {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            m.data()[k] = static_cast<T>(static_cast<double>(seed >> 40) / static_cast<double>(1 << 24) * 4.0 - 2.0);
+        }
+    }
+    return matrices;
+}
+
+template<typename T>
+static T det3(tinyla::mat<3,T> const& m)
+{
+    return m[0, 0] * (m[1, 1] * m[2, 2] - m[2, 1] * m[1, 2])
+         - m[0, 1] * (m[1, 0] * m[2, 2] - m[2, 0] * m[1, 2])
+         + m[0, 2] * (m[1, 0] * m[2, 1] - m[2, 0] * m[1, 1]);
+}
+
+template<typename T>
+static void require_rotation(tinyla::mat<3,T> const& r, T margin)
+{
+    compare(r.transposed() * r, tinyla::mat<3,T>{tinyla::mat_init::identity}, margin);
+    REQUIRE(det3(r) == Catch::Approx(T{1}).margin(margin));
+}
+
+TEMPLATE_TEST_CASE("mat3 symmetric eigen-decomposition", "[mat3]", float, double)
+{
+    constexpr auto margin = std::is_same_v<TestType, float> ? TestType{1e-4} : TestType{1e-11};
+    auto inputs = make_matrices<TestType>(200, 1);
+    // Repeated and zero eigenvalues.
+    inputs.push_back(tinyla::mat<3,TestType>{tinyla::mat_init::identity});
+    inputs.push_back(tinyla::mat<3,TestType>{tinyla::mat_init::zero});
+    inputs.push_back(tinyla::mat<3,TestType>{1, 1, 0, 1, 1, 0, 0, 0, 2});
+
+    for (auto const& m : inputs) {
+        auto a = m;
+        for (std::size_t i = 0; i < 3; ++i) {
+            for (std::size_t j = 0; j < 3; ++j) a[i, j] = m[i, j] + m[j, i];
+        }
+        auto const e = tinyla::symmetric_eigen(a);
+        REQUIRE(e.values[0] >= e.values[1]);
+        REQUIRE(e.values[1] >= e.values[2]);
+        require_rotation(e.vectors, margin);
+
+        auto const d = tinyla::mat<3,TestType>{tinyla::mat_init::diagonal, e.values};
+        compare(e.vectors * d * e.vectors.transposed(), a, margin);
+    }
+
+    constexpr auto e = tinyla::symmetric_eigen(tinyla::mat<3,TestType>{2, 0, 0, 0, 3, 0, 0, 0, 1});
+    static_assert(e.values[0] == 3 && e.values[1] == 2 && e.values[2] == 1);
+}
+
+TEMPLATE_TEST_CASE("mat3 singular value decomposition", "[mat3]", float, double)
+{
+    constexpr auto margin = std::is_same_v<TestType, float> ? TestType{1e-4} : TestType{1e-10};
+    auto inputs = make_matrices<TestType>(200, 2);
+    // Reflection, rank one and zero.
+    inputs.push_back(tinyla::mat<3,TestType>{tinyla::mat_init::diagonal, tinyla::vec<3,TestType>{1, -2, 3}});
+    inputs.push_back(tinyla::mat<3,TestType>{1, 2, 3, 2, 4, 6, 3, 6, 9});
+    inputs.push_back(tinyla::mat<3,TestType>{tinyla::mat_init::zero});
+
+    for (auto const& a : inputs) {
+        auto const r = tinyla::svd(a);
+        require_rotation(r.u, margin);
+        require_rotation(r.v, margin);
+        REQUIRE(r.sigma[0] >= r.sigma[1] - margin);
+        REQUIRE(r.sigma[1] >= tinyla::abs(r.sigma[2]) - margin);
+        REQUIRE(r.sigma[1] >= TestType{0});
+
+        auto const s = tinyla::mat<3,TestType>{tinyla::mat_init::diagonal, r.sigma};
+        compare(r.u * s * r.v.transposed(), a, margin);
+    }
+}
+
+TEMPLATE_TEST_CASE("mat3 batched eigen and svd", "[mat3]", float, double)
+{
+    // The lane kernels may contract to FMA differently from the single-matrix versions.
+    constexpr auto epsilon = std::is_same_v<TestType, float> ? 1e-5 : 1e-12;
+    constexpr auto margin = std::is_same_v<TestType, float> ? TestType{1e-4} : TestType{1e-10};
+    auto const inputs = make_matrices<TestType>(3001, 3);
+    auto eigen = std::vector<tinyla::eigen3<TestType>>(inputs.size(), tinyla::symmetric_eigen(inputs[0]));
+    auto svd = std::vector<tinyla::svd3<TestType>>(inputs.size(), tinyla::svd(inputs[0]));
+    tinyla::symmetric_eigen<TestType>(inputs, eigen, tinyla::parallel::options{.threads = 3});
+    tinyla::svd<TestType>(inputs, svd);
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        CAPTURE(i);
+        auto const e = tinyla::symmetric_eigen(inputs[i]);
+        auto const s = tinyla::svd(inputs[i]);
+        for (std::size_t k = 0; k < 3; ++k) {
+            REQUIRE(eigen[i].values[k] == Catch::Approx(e.values[k]).epsilon(epsilon).margin(margin));
+            REQUIRE(svd[i].sigma[k] == Catch::Approx(s.sigma[k]).epsilon(epsilon).margin(margin));
+        }
+        require_rotation(eigen[i].vectors, margin);
+        require_rotation(svd[i].u, margin);
+        require_rotation(svd[i].v, margin);
+        auto const sigma = tinyla::mat<3,TestType>{tinyla::mat_init::diagonal, svd[i].sigma};
+        compare(svd[i].u * sigma * svd[i].v.transposed(), inputs[i], margin);
+    }
+}
+
+int main(int argc, const char* argv[])
+{
+    return Catch::Session().run(argc, argv);
+}
@@ -0,0 +1,172 @@
+#include <tinyla/fixed.hpp>
+#include <tinyla/geom.hpp>
+#include <tinyla/mat.hpp>
+#include <tinyla/vec.hpp>
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch_all.hpp>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <vector>
+
+using tinyla::q16_16;
+#if defined(__SIZEOF_INT128__)
+using tinyla::q32_32;
+#endif
+
+TEST_CASE("fixed arithmetic", "[fixed]")
+{
+    STATIC_REQUIRE(q16_16{1}.raw() == 65536);
+    STATIC_REQUIRE(q16_16{-1.5}.raw() == -98304);
+    STATIC_REQUIRE(q16_16{1.5} * q16_16{2.25} == q16_16{3.375});
+    STATIC_REQUIRE(q16_16{7} / q16_16{2} == q16_16{3.5});
+    STATIC_REQUIRE(q16_16{-7} / q16_16{2} == q16_16{-3.5});
+    STATIC_REQUIRE(q16_16{1.25} * 4 == q16_16{5});
+    STATIC_REQUIRE(q16_16{5} / 4 == q16_16{1.25});
+    STATIC_REQUIRE(q16_16{2} - q16_16{3} < q16_16{0});
+    STATIC_REQUIRE(static_cast<int>(q16_16{-2.75}) == -2);
+#if defined(__SIZEOF_INT128__)
+    STATIC_REQUIRE(static_cast<double>(q32_32{0.125}) == 0.125);
+#endif
+
+    // Products round to nearest: 3 * 2^-16 * 0.5 = 1.5 units, rounded up to 2.
+    REQUIRE((q16_16::from_raw(3) * q16_16{0.5}).raw() == 2);
+    REQUIRE((q16_16::from_raw(1) * q16_16::from_raw(1)).raw() == 0);
+    // Additions wrap rather than being undefined.
+    REQUIRE(std::numeric_limits<q16_16>::max() + std::numeric_limits<q16_16>::epsilon() == std::numeric_limits<q16_16>::lowest());
+    REQUIRE(-std::numeric_limits<q16_16>::lowest() == std::numeric_limits<q16_16>::lowest());
+    REQUIRE(tinyla::abs(q16_16{-3}) == q16_16{3});
+}
+
+TEST_CASE("fixed sqrt", "[fixed]")
+{
+    STATIC_REQUIRE(tinyla::sqrt(q16_16{4}) == q16_16{2});
+#if defined(__SIZEOF_INT128__)
+    STATIC_REQUIRE(tinyla::sqrt(q32_32{2.25}) == q32_32{1.5});
+#endif
+    REQUIRE(tinyla::sqrt(q16_16{0}) == q16_16{0});
+
+    for (int i = 0; i < 10000; ++i) {
+#if defined(__SIZEOF_INT128__)
+        auto const x = q32_32{i * 0.731};
+        auto const expected = std::sqrt(static_cast<double>(x));
+        REQUIRE(tinyla::abs(static_cast<double>(tinyla::sqrt(x)) - expected) <= 0.5 / 4294967296.0 + 1e-15 * expected);
+#endif
+        auto const y = q16_16{i * 0.0731};
+        REQUIRE(tinyla::abs(static_cast<double>(tinyla::sqrt(y)) - std::sqrt(static_cast<double>(y))) <= 0.5 / 65536.0);
+    }
+}
+
+#if defined(__SIZEOF_INT128__)
+TEMPLATE_TEST_CASE("fixed sin and cos", "[fixed]", q16_16, q32_32)
+#else
+TEMPLATE_TEST_CASE("fixed sin and cos", "[fixed]", q16_16)
+#endif
+{
+    constexpr auto ulp = 1.0 / static_cast<double>(std::uint64_t{1} << TestType::fractional_bits);
+    STATIC_REQUIRE(tinyla::sin(TestType{0}) == TestType{0});
+    STATIC_REQUIRE(tinyla::cos(TestType{0}) == TestType{1});
+
+    for (int i = -20000; i <= 20000; ++i) {
+        auto const x = TestType{i * 0.0013};
+        auto const sc = tinyla::sincos(x);
+        auto const exact = static_cast<double>(x);
+        CAPTURE(exact);
+        REQUIRE(tinyla::abs(static_cast<double>(sc.sin) - std::sin(exact)) <= 6 * ulp);
+        REQUIRE(tinyla::abs(static_cast<double>(sc.cos) - std::cos(exact)) <= 6 * ulp);
+        REQUIRE(tinyla::sin(x) == sc.sin);
+        REQUIRE(tinyla::cos(x) == sc.cos);
+    }
+    REQUIRE(static_cast<double>(tinyla::tan(TestType{0.5})) == Catch::Approx(std::tan(0.5)).margin(64 * ulp));
+}
+
+#if defined(__SIZEOF_INT128__)
+TEST_CASE("fixed vec and mat", "[fixed]")
+{
+    using vec3 = tinyla::vec<3,q32_32>;
+    constexpr auto a = vec3{q32_32{3}, q32_32{4}, q32_32{0}};
+    constexpr auto b = vec3{q32_32{0}, q32_32{0}, q32_32{2}};
+    STATIC_REQUIRE(a.length() == q32_32{5});
+    STATIC_REQUIRE(dot(a, b) == q32_32{0});
+    constexpr auto c = cross(a, b);
+    STATIC_REQUIRE(c.x() == q32_32{8});
+    STATIC_REQUIRE(c.y() == q32_32{-6});
+    constexpr auto n = a.normalized();
+    STATIC_REQUIRE(tinyla::close(n.x(), q32_32{0.6}));
+    STATIC_REQUIRE(tinyla::close(n.y(), q32_32{0.8}));
+
+    // Scalar operations take the vector's own scalar type.
+    STATIC_REQUIRE((a * q32_32{0.5}).y() == q32_32{2});
+    STATIC_REQUIRE((a / q32_32{2}).x() == q32_32{1.5});
+
+    auto const t = tinyla::geom::translation(tinyla::vec<3,q32_32>{q32_32{1}, q32_32{-2}, q32_32{3}});
+    auto const product = t * t.inverted();
+    for (std::size_t i = 0; i < 4; ++i) {
+        for (std::size_t j = 0; j < 4; ++j) REQUIRE(product[i, j] == q32_32{i == j ? 1 : 0});
+    }
+}
+#endif
+
+#if defined(__SIZEOF_INT128__)
+TEMPLATE_TEST_CASE("fixed rotation is the same at compile time and at run time", "[fixed]", q16_16, q32_32)
+#else
+TEMPLATE_TEST_CASE("fixed rotation is the same at compile time and at run time", "[fixed]", q16_16)
+#endif
+{
+    using vec3 = tinyla::vec<3,TestType>;
+    constexpr auto axis = vec3{TestType{1}, TestType{2}, TestType{-2}};
+    constexpr auto angle = tinyla::geom::angle<TestType>::from_degrees(TestType{30});
+    constexpr auto compile_time = tinyla::geom::rotation(angle, axis);
+
+    auto volatile degrees = 30;
+    auto const run_time = tinyla::geom::rotation(tinyla::geom::angle<TestType>::from_degrees(TestType{degrees}), axis);
+    auto const reference = tinyla::geom::rotation(tinyla::geom::angle<double>::from_degrees(30.0),
+                                                  tinyla::vec3d{1.0, 2.0, -2.0});
+    for (std::size_t i = 0; i < 4; ++i) {
+        for (std::size_t j = 0; j < 4; ++j) {
+            REQUIRE(run_time[i, j].raw() == compile_time[i, j].raw());
+            REQUIRE(static_cast<double>(run_time[i, j]) == Catch::Approx(reference[i, j]).margin(1e-3));
+        }
+    }
+}
+
+#if defined(__SIZEOF_INT128__)
+TEMPLATE_TEST_CASE("fixed bulk kernels match the scalar operators", "[fixed]", q16_16, q32_32)
+#else
+TEMPLATE_TEST_CASE("fixed bulk kernels match the scalar operators", "[fixed]", q16_16)
+#endif
+{
+    std::uint64_t seed = 11;
+    auto const random = [&seed] {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        return TestType{static_cast<double>(seed >> 40) / static_cast<double>(1 << 24) * 200.0 - 100.0};
+    };
+    constexpr std::size_t count = 1001;
+    std::vector<TestType> xs[6];
+    for (auto& v : xs) {
+        for (std::size_t i = 0; i < count; ++i) v.push_back(random());
+    }
+    auto const s = random();
+    auto out = std::vector<TestType>(count);
+
+    tinyla::multiply(std::span<const TestType>{xs[0]}, std::span<const TestType>{xs[1]}, std::span<TestType>{out});
+    for (std::size_t i = 0; i < count; ++i) REQUIRE(out[i] == xs[0][i] * xs[1][i]);
+
+    tinyla::multiply_add(std::span<const TestType>{xs[0]}, s, std::span<const TestType>{xs[1]}, std::span<TestType>{out});
+    for (std::size_t i = 0; i < count; ++i) REQUIRE(out[i] == xs[0][i] * s + xs[1][i]);
+
+    tinyla::dot_soa(std::span<const TestType>{xs[0]}, std::span<const TestType>{xs[1]}, std::span<const TestType>{xs[2]},
+                    std::span<const TestType>{xs[3]}, std::span<const TestType>{xs[4]}, std::span<const TestType>{xs[5]},
+                    std::span<TestType>{out});
+    for (std::size_t i = 0; i < count; ++i) {
+        auto const a = tinyla::vec<3,TestType>{xs[0][i], xs[1][i], xs[2][i]};
+        auto const b = tinyla::vec<3,TestType>{xs[3][i], xs[4][i], xs[5][i]};
+        REQUIRE(out[i] == dot(a, b));
+    }
+}
+
+int main(int argc, const char* argv[])
+{
+    return Catch::Session().run(argc, argv);
+}
@@ -1,8 +1,43 @@
+#include <tinyla/batch.hpp>
 #include <tinyla/geom.hpp>
 #include <tinyla/mat.hpp>
+#include <tinyla/matx.hpp>
 #include <tinyla/util.hpp>
+#include "baseline.hpp"
+#include "perf_counters.hpp"
 #define CATCH_CONFIG_RUNNER
 #include <catch2/catch_all.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Hardware counters read around every benchmark, opened in main with --perf-counters.
+std::optional<perf::counters> perf_counters;
+
+// Samples taken of every benchmark for --baseline-record and --baseline-compare, none without them.
+std::size_t baseline_samples = 0;
+baseline::results baseline_results;
+
+/**
+* Catch2 benchmark of f, followed by its hardware counters per call and per element and by its baseline samples
+* when they are enabled; elements is the amount of work one call of f does, in whatever unit compares competing
+* implementations.
+*/
+template<typename F>
+void benchmark(std::string const& name, std::size_t elements, F&& f)
+{
+    BENCHMARK(std::string{name}) { return f(); };
+
+    auto const call = [&] { Catch::Benchmark::deoptimize_value(f()); };
+    if (perf_counters) {
+        perf::report(name, elements, perf::per_call(*perf_counters, call));
+    }
+    if (baseline_samples != 0) {
+        baseline_results[name] = baseline::sample(call, baseline_samples);
+    }
+}
 
 constexpr auto zero = tinyla::mat4f {
     0.0f, 0.0f, 0.0f, 0.0f,
@@ -27,38 +62,164 @@ constexpr auto identity = tinyla::mat4f {
 
 TEST_CASE("mat4 scaling benchmark", "[mat4]")
 {
-    BENCHMARK("pre-scale by pre_scale") {
+    benchmark("pre-scale by pre_scale", 1, [&] {
         auto m = unique;
         tinyla::geom::pre_scale(m, tinyla::vec3f{2.0f, 3.0f, 4.0f});
         return m;
-    };
+    });
 
-    BENCHMARK("pre-scale by matrix multiplication") {
+    benchmark("pre-scale by matrix multiplication", 1, [&] {
         auto t = tinyla::geom::scaling(tinyla::vec3f{2.0f, 3.0f, 4.0f});
         auto m = unique;
         m = t * m;
         return m;
-    };
+    });
 }
 
 TEST_CASE("mat4 translation benchmark", "[mat4]")
 {
-    BENCHMARK("pre-translate by pre_translate") {
+    benchmark("pre-translate by pre_translate", 1, [&] {
         auto m = unique;
         tinyla::geom::pre_translate(m, tinyla::vec3f{1.0f, 2.0f, 3.0f});
         return m;
-    };
+    });
 
-    BENCHMARK("pre-translate by matrix multiplication") {
+    benchmark("pre-translate by matrix multiplication", 1, [&] {
         auto t = tinyla::geom::translation(tinyla::vec3f{1.0f, 2.0f, 3.0f});
         auto m = unique;
         m = t * m;
         return m;
-    };
+    });
+}
+
+TEST_CASE("mat4 look_at benchmark", "[mat4]")
+{
+    constexpr auto eye = tinyla::vec3f{1.0f, 2.0f, 3.0f};
+    constexpr auto target = tinyla::vec3f{0.0f, 0.0f, 0.0f};
+    constexpr auto up = tinyla::vec3f{0.0f, 1.0f, 0.0f};
+
+    benchmark("view and inverse by look_at", 1, [&] {
+        return tinyla::geom::look_at(eye, target, up, tinyla::geom::handedness::right);
+    });
+
+    benchmark("view and inverse by inverted", 1, [&] {
+        auto const view = tinyla::geom::look_at(eye, target, up, tinyla::geom::handedness::right).matrix;
+        return view.inverted();
+    });
+}
+
+TEST_CASE("mat4 batched multiply benchmark", "[mat4]")
+{
+    auto const models = std::vector<tinyla::mat4f>(4096, unique);
+    auto out = std::vector<tinyla::mat4f>(models.size(), zero);
+
+    benchmark("view-projection times models by operator*", models.size(), [&] {
+        for (std::size_t i = 0; i < models.size(); ++i) out[i] = identity * models[i];
+        return out.back();
+    });
+
+    benchmark("view-projection times models by multiply", models.size(), [&] {
+        tinyla::multiply(identity, models, out);
+        return out.back();
+    });
+}
+
+TEST_CASE("matx gemm benchmark", "[matx]")
+{
+    constexpr std::size_t n = 256;
+    auto a = tinyla::matx<float>{n, n, tinyla::mat_init::identity};
+    auto b = tinyla::matx<float>{n, n, tinyla::mat_init::identity};
+    auto c = tinyla::matx<float>{n, n};
+    for (std::size_t j = 0; j < n; ++j) {
+        for (std::size_t i = 0; i < n; ++i) a[i, j] = b[j, i] = static_cast<float>((i + 2 * j) % 7);
+    }
+
+    // elements are multiply-adds
+    benchmark("256x256 product by i-j-k loop", n * n * n, [&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t j = 0; j < n; ++j) {
+                float s = 0.0f;
+                for (std::size_t k = 0; k < n; ++k) s += a[i, k] * b[k, j];
+                c[i, j] = s;
+            }
+        }
+        return c[n - 1, n - 1];
+    });
+
+    benchmark("256x256 product by gemm", n * n * n, [&] {
+        tinyla::gemm(1.0f, a.view(), b.view(), 0.0f, c.view());
+        return c[n - 1, n - 1];
+    });
 }
 
 int main(int argc, const char* argv[])
 {
-    return Catch::Session().run(argc, argv);
+    auto session = Catch::Session();
+
+    auto enable_perf_counters = false;
+    auto vector_event = std::string{};
+    auto record = std::string{};
+    auto compare = std::string{};
+    auto samples = std::size_t{20};
+    auto tolerance = 0.05;
+    auto alpha = 0.01;
+    session.cli(session.cli()
+        | Catch::Clara::Opt(enable_perf_counters)
+            ["--perf-counters"]
+            ("read hardware counters around every benchmark (Linux perf_event_open)")
+        | Catch::Clara::Opt(vector_event, "raw event code")
+            ["--perf-vector-event"]
+            ("raw perf event counting vector instructions, 0 to disable (default: CPU specific)")
+        | Catch::Clara::Opt(record, "file")
+            ["--baseline-record"]
+            ("write the timings of every benchmark to a baseline file")
+        | Catch::Clara::Opt(compare, "file")
+            ["--baseline-compare"]
+            ("compare the timings of every benchmark with a baseline file, failing on regressions")
+        | Catch::Clara::Opt(samples, "count")
+            ["--baseline-samples"]
+            ("timings per benchmark for the baseline (default: 20)")
+        | Catch::Clara::Opt(tolerance, "fraction")
+            ["--baseline-tolerance"]
+            ("slowdown against the baseline that is not a regression (default: 0.05)")
+        | Catch::Clara::Opt(alpha, "p-value")
+            ["--baseline-alpha"]
+            ("significance level of the regression test (default: 0.01)"));
+
+    if (auto const result = session.applyCommandLine(argc, argv); result != 0) return result;
+
+    if (enable_perf_counters) {
+        auto event = perf::default_vector_event();
+        if (!vector_event.empty()) {
+            auto const code = std::stoull(vector_event, nullptr, 0);
+            event = code != 0 ? std::optional<std::uint64_t>{code} : std::nullopt;
+        }
+        perf_counters.emplace(event);
+        if (!perf_counters->available()) {
+            std::fprintf(stderr, "perf_event_open is unavailable, benchmarks run without hardware counters\n");
+            perf_counters.reset();
+        }
+    }
+
+    auto baseline = std::optional<baseline::results>{};
+    if (!compare.empty()) {
+        baseline = baseline::read(compare);
+        if (!baseline) {
+            std::fprintf(stderr, "cannot read baseline %s\n", compare.c_str());
+            return 2;
+        }
+    }
+    if (!record.empty() || baseline) baseline_samples = std::max<std::size_t>(samples, 2);
+
+    auto result = session.run();
+
+    if (!record.empty() && !baseline::write(record, baseline_results)) {
+        std::fprintf(stderr, "cannot write baseline %s\n", record.c_str());
+        result = std::max(result, 2);
+    }
+    if (baseline && baseline::compare(*baseline, baseline_results, tolerance, alpha) != 0) {
+        result = std::max(result, 1);
+    }
+    return result;
 }
 
@@ -6,6 +6,7 @@
 #include "compare.hpp"
 #include "data.hpp"
 #include <array>
+#include <vector>
 
 using namespace tinyla::geom::literals;
 
@@ -23,6 +24,70 @@ TEST_CASE("mat4 perspective", "[mat4]")
     compare(m, a);
 }
 
+TEST_CASE("mat4 orthographic", "[mat4]")
+{
+    constexpr auto box = tinyla::geom::view_box{-2.0f, 4.0f, -1.0f, 3.0f, 0.5f, 10.0f};
+    {
+        const auto p = tinyla::geom::orthographic(box,
+            tinyla::geom::handedness::right, tinyla::geom::clip_volume::minus_one_to_one);
+        constexpr auto a = std::array<std::array<float, 4>, 4> {
+            0.333333f, 0.000000f,  0.000000f, -0.333333f,
+            0.000000f, 0.500000f,  0.000000f, -0.500000f,
+            0.000000f, 0.000000f, -0.210526f, -1.105263f,
+            0.000000f, 0.000000f,  0.000000f,  1.000000f
+        };
+        compare(p.matrix, a);
+        compare(p.matrix * p.inverse, identity, 1e-6f);
+        compare(p.matrix * tinyla::vec4f{-2.0f, -1.0f, -0.5f, 1.0f}, std::array{-1.0f, -1.0f, -1.0f, 1.0f}, 1e-6f);
+        compare(p.matrix * tinyla::vec4f{4.0f, 3.0f, -10.0f, 1.0f}, std::array{1.0f, 1.0f, 1.0f, 1.0f}, 1e-6f);
+    }
+    {
+        const auto p = tinyla::geom::orthographic(box,
+            tinyla::geom::handedness::right, tinyla::geom::clip_volume::zero_to_one);
+        compare(p.matrix * p.inverse, identity, 1e-6f);
+        compare(p.matrix * tinyla::vec4f{-2.0f, -1.0f, -0.5f, 1.0f}, std::array{-1.0f, -1.0f, 0.0f, 1.0f}, 1e-6f);
+        compare(p.matrix * tinyla::vec4f{4.0f, 3.0f, -10.0f, 1.0f}, std::array{1.0f, 1.0f, 1.0f, 1.0f}, 1e-6f);
+    }
+    {
+        const auto p = tinyla::geom::orthographic(box,
+            tinyla::geom::handedness::left, tinyla::geom::clip_volume::minus_one_to_one);
+        compare(p.matrix * p.inverse, identity, 1e-6f);
+        compare(p.matrix * tinyla::vec4f{-2.0f, -1.0f, 0.5f, 1.0f}, std::array{-1.0f, -1.0f, -1.0f, 1.0f}, 1e-6f);
+        compare(p.matrix * tinyla::vec4f{4.0f, 3.0f, 10.0f, 1.0f}, std::array{1.0f, 1.0f, 1.0f, 1.0f}, 1e-6f);
+    }
+    {
+        const auto p = tinyla::geom::orthographic(box,
+            tinyla::geom::handedness::left, tinyla::geom::clip_volume::zero_to_one);
+        compare(p.matrix * p.inverse, identity, 1e-6f);
+        compare(p.matrix * tinyla::vec4f{-2.0f, -1.0f, 0.5f, 1.0f}, std::array{-1.0f, -1.0f, 0.0f, 1.0f}, 1e-6f);
+        compare(p.matrix * tinyla::vec4f{4.0f, 3.0f, 10.0f, 1.0f}, std::array{1.0f, 1.0f, 1.0f, 1.0f}, 1e-6f);
+    }
+}
+
+TEST_CASE("mat4 look_at", "[mat4]")
+{
+    constexpr auto eye = tinyla::vec3f{1.0f, 2.0f, 3.0f};
+    constexpr auto target = tinyla::vec3f{0.0f, 0.0f, 0.0f};
+    constexpr auto up = tinyla::vec3f{0.0f, 1.0f, 0.0f};
+    {
+        const auto v = tinyla::geom::look_at(eye, target, up, tinyla::geom::handedness::right);
+        constexpr auto a = std::array<std::array<float, 4>, 4> {
+             0.948683f, 0.000000f, -0.316228f,  0.000000f,
+            -0.169031f, 0.845154f, -0.507093f,  0.000000f,
+             0.267261f, 0.534522f,  0.801784f, -3.741657f,
+             0.000000f, 0.000000f,  0.000000f,  1.000000f
+        };
+        compare(v.matrix, a, 1e-6f);
+        compare(v.matrix * v.inverse, identity, 1e-6f);
+        compare(v.inverse * tinyla::vec4f{0.0f, 0.0f, 0.0f, 1.0f}, std::array{1.0f, 2.0f, 3.0f, 1.0f}, 1e-6f);
+    }
+    {
+        const auto v = tinyla::geom::look_at(eye, target, up, tinyla::geom::handedness::left);
+        compare(v.matrix * v.inverse, identity, 1e-6f);
+        compare(v.matrix * tinyla::vec4f{0.0f, 0.0f, 0.0f, 1.0f}, std::array{0.0f, 0.0f, 3.741657f, 1.0f}, 1e-6f);
+    }
+}
+
 TEST_CASE("mat4 scaling", "[mat4]")
 {
     const auto m = tinyla::geom::scaling(tinyla::vec3f{2.0f, 3.0f, 4.0f});
@@ -181,6 +246,170 @@ TEST_CASE("mat4 post_rotate around z-axis", "[mat4]")
     compare(m, a);
 }
 
+TEST_CASE("mat4 rotations by cached angle", "[mat4]")
+{
+    constexpr auto angle = tinyla::geom::cached_angle{30.0_degf};
+    static_assert(tinyla::abs(angle.sin() - 0.5f) < 1e-6f);
+
+    auto const axes = std::array{
+        tinyla::vec3f{1.0f, 0.0f, 0.0f},
+        tinyla::vec3f{0.0f, 1.0f, 0.0f},
+        tinyla::vec3f{0.0f, 0.0f, 1.0f},
+        tinyla::vec3f{1.0f, 2.0f, 3.0f}
+    };
+    for (auto const& axis : axes) {
+        compare(tinyla::geom::rotation(angle, axis), tinyla::geom::rotation(30.0_degf, axis));
+
+        auto m1 = unique;
+        auto m2 = unique;
+        tinyla::geom::pre_rotate(m1, -angle, axis);
+        tinyla::geom::pre_rotate(m2, -30.0_degf, axis);
+        compare(m1, m2);
+
+        tinyla::geom::post_rotate(m1, angle, axis);
+        tinyla::geom::post_rotate(m2, 30.0_degf, axis);
+        compare(m1, m2);
+    }
+}
+
+TEST_CASE("batched sincos of angles", "[mat4]")
+{
+    auto angles = std::vector<tinyla::geom::angle<double>>{};
+    for (int i = -500; i < 500; ++i) angles.push_back(tinyla::geom::angle<double>::from_degrees(i * 1.7));
+    auto cached = std::vector(angles.size(), tinyla::geom::cached_angle{0.0_radd});
+    tinyla::geom::sincos<double>(angles, cached);
+    for (std::size_t i = 0; i < angles.size(); ++i) {
+        REQUIRE(cached[i].radians() == angles[i].radians());
+        REQUIRE(cached[i].sin() == Catch::Approx(std::sin(angles[i].radians())).margin(1e-15));
+        REQUIRE(cached[i].cos() == Catch::Approx(std::cos(angles[i].radians())).margin(1e-15));
+    }
+}
+
+TEST_CASE("mat4 camera_relative", "[mat4]")
+{
+    constexpr auto eye = tinyla::vec3d{1.0e6 + 0.25, 2.0e6 + 0.5, -3.0e6 + 0.75};
+    auto const view = tinyla::geom::look_at(eye, eye + tinyla::vec3d{0.0, 0.0, -1.0},
+        tinyla::vec3d{0.0, 1.0, 0.0}, tinyla::geom::handedness::right).matrix;
+    auto model = tinyla::geom::translation(eye + tinyla::vec3d{1.0, 2.0, -3.0});
+    tinyla::geom::post_scale(model, tinyla::vec3d{2.0, 2.0, 2.0});
+
+    auto const expected = (view * model).cast<float>();
+    compare(tinyla::geom::camera_relative(view, eye, model), expected, 1e-6f);
+
+    auto const models = std::array{model, model};
+    auto out = std::array{zero, zero};
+    tinyla::geom::camera_relative(view, eye, models, out);
+    compare(out[0], expected, 1e-6f);
+    compare(out[1], expected, 1e-6f);
+
+    auto const points = std::array{eye + tinyla::vec3d{1.0, 2.0, -3.0}, eye};
+    auto relative = std::array{tinyla::vec3f{tinyla::vec_init::zero}, tinyla::vec3f{tinyla::vec_init::zero}};
+    tinyla::geom::camera_relative(points, eye, relative);
+    compare(relative[0], std::array{1.0f, 2.0f, -3.0f});
+    compare(relative[1], std::array{0.0f, 0.0f, 0.0f});
+}
+
+TEST_CASE("mat4 transforms are constant evaluated", "[mat4]")
+{
+    constexpr auto frustum = tinyla::geom::frustum{60.0_degf, 1.0f, 0.1f, 1000.0f};
+    constexpr auto p = tinyla::geom::perspective(frustum,
+        tinyla::geom::handedness::right, tinyla::geom::clip_volume::minus_one_to_one);
+    STATIC_REQUIRE(p[3, 2] == -1.0f);
+    compare(p, tinyla::geom::perspective(frustum,
+        tinyla::geom::handedness::right, tinyla::geom::clip_volume::minus_one_to_one));
+
+    constexpr auto axis = tinyla::vec3f{1.0f, 2.0f, 3.0f};
+    constexpr auto r = tinyla::geom::rotation(45.0_degf, axis);
+    compare(r, tinyla::geom::rotation(45.0_degf, axis), 1e-6f);
+
+    constexpr auto m = [] {
+        auto m = tinyla::geom::translation(tinyla::vec3f{1.0f, 2.0f, 3.0f});
+        tinyla::geom::pre_rotate(m, 30.0_degf, {0.0f, 0.0f, 1.0f});
+        tinyla::geom::post_rotate(m, 30.0_degf, {1.0f, 1.0f, 0.0f});
+        tinyla::geom::post_scale(m, tinyla::vec3f{2.0f, 2.0f, 2.0f});
+        return m;
+    }();
+    auto expected = tinyla::geom::translation(tinyla::vec3f{1.0f, 2.0f, 3.0f});
+    tinyla::geom::pre_rotate(expected, 30.0_degf, {0.0f, 0.0f, 1.0f});
+    tinyla::geom::post_rotate(expected, 30.0_degf, {1.0f, 1.0f, 0.0f});
+    tinyla::geom::post_scale(expected, tinyla::vec3f{2.0f, 2.0f, 2.0f});
+    compare(m, expected, 1e-6f);
+
+    constexpr auto v = tinyla::geom::look_at(tinyla::vec3f{1.0f, 2.0f, 3.0f}, tinyla::vec3f{0.0f, 0.0f, 0.0f},
+        tinyla::vec3f{0.0f, 1.0f, 0.0f}, tinyla::geom::handedness::right);
+    compare(v.matrix * v.inverse, identity, 1e-6f);
+}
+
+TEST_CASE("mat4 decompose and compose", "[mat4]")
+{
+    auto m = tinyla::geom::translation(tinyla::vec3f{1.0f, -2.0f, 3.0f});
+    tinyla::geom::post_rotate(m, 30.0_degf, {1.0f, 2.0f, 3.0f});
+    tinyla::geom::post_scale(m, tinyla::vec3f{2.0f, 0.5f, 4.0f});
+
+    for (auto decomposition : {tinyla::geom::decomposition::orthogonal, tinyla::geom::decomposition::polar}) {
+        auto const d = tinyla::geom::decompose(m, decomposition);
+        compare(d.translation, std::array{1.0f, -2.0f, 3.0f});
+        compare(d.scale, std::array{2.0f, 0.5f, 4.0f});
+        auto r = tinyla::geom::rotation(30.0_degf, tinyla::vec3f{1.0f, 2.0f, 3.0f});
+        for (std::size_t i = 0; i < 3; ++i) {
+            for (std::size_t j = 0; j < 3; ++j) {
+                CAPTURE(i, j);
+                REQUIRE(d.rotation[i, j] == Catch::Approx(r[i, j]).margin(1e-6f));
+            }
+        }
+        compare(tinyla::geom::compose(d), m, 1e-6f);
+    }
+}
+
+TEST_CASE("mat4 decompose with reflection", "[mat4]")
+{
+    auto m = tinyla::geom::scaling(tinyla::vec3f{-2.0f, 3.0f, 4.0f});
+    tinyla::geom::pre_rotate(m, 90.0_degf, {0.0f, 0.0f, 1.0f});
+    auto const d = tinyla::geom::decompose(m);
+    compare(d.scale, std::array{-2.0f, 3.0f, 4.0f});
+    compare(tinyla::geom::compose(d), m, 1e-6f);
+}
+
+TEST_CASE("mat4 decompose with shear", "[mat4]")
+{
+    auto m = tinyla::mat4d{tinyla::mat_init::identity};
+    m[0, 1] = 0.5;
+    tinyla::geom::post_rotate(m, tinyla::geom::angle<double>::from_degrees(20.0), {0.0, 1.0, 1.0});
+    auto const d = tinyla::geom::decompose(m, tinyla::geom::decomposition::polar);
+    // The rotation is orthonormal even though the input is not.
+    for (std::size_t i = 0; i < 3; ++i) {
+        for (std::size_t j = 0; j < 3; ++j) {
+            double dot = 0.0;
+            for (std::size_t k = 0; k < 3; ++k) dot += d.rotation[k, i] * d.rotation[k, j];
+            CAPTURE(i, j);
+            REQUIRE(dot == Catch::Approx(i == j ? 1.0 : 0.0).margin(1e-12));
+        }
+    }
+}
+
+TEST_CASE("mat4 batched decompose and compose", "[mat4]")
+{
+    auto ms = std::array{identity, identity, identity};
+    tinyla::geom::post_translate(ms[1], tinyla::vec3f{1.0f, 2.0f, 3.0f});
+    tinyla::geom::post_rotate(ms[1], 45.0_degf, {0.0f, 1.0f, 0.0f});
+    tinyla::geom::post_scale(ms[2], tinyla::vec3f{2.0f, 2.0f, 3.0f});
+
+    auto t = std::vector<tinyla::vec3f>(ms.size(), tinyla::vec3f{tinyla::vec_init::zero});
+    auto r = std::vector<tinyla::mat3f>(ms.size(), tinyla::mat3f{tinyla::mat_init::zero});
+    auto s = t;
+    tinyla::geom::decompose<float>(ms, t, r, s);
+
+    auto out = std::vector<tinyla::mat4f>(ms.size(), zero);
+    tinyla::geom::compose<float>(t, r, s, out);
+    for (std::size_t i = 0; i < ms.size(); ++i) {
+        CAPTURE(i);
+        auto const d = tinyla::geom::decompose(ms[i]);
+        compare(t[i], d.translation);
+        compare(s[i], d.scale);
+        compare(out[i], ms[i], 1e-6f);
+    }
+}
+
 int main(int argc, const char* argv[])
 {
     return Catch::Session().run(argc, argv);
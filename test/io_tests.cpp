@@ -0,0 +1,139 @@
+#include <tinyla/io.hpp>
+#include <tinyla/mat.hpp>
+#include <tinyla/vec.hpp>
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch_all.hpp>
+#include "compare.hpp"
+#include "data.hpp"
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+static std::filesystem::path temp_file(char const* name)
+{
+    return std::filesystem::temp_directory_path() / name;
+}
+
+static std::vector<tinyla::vec3f> make_points(std::size_t count)
+{
+    auto points = std::vector<tinyla::vec3f>{};
+    for (std::size_t i = 0; i < count; ++i) {
+        points.emplace_back(float(i), float(i) * 0.5f, -float(i));
+    }
+    return points;
+}
+
+TEST_CASE("io writes and maps AoS mat4 arrays", "[io]")
+{
+    auto const path = temp_file("tinyla_io_tests_mat4.bin");
+    auto const ms = std::vector<tinyla::mat4f>{unique, identity, zero};
+    REQUIRE(!tinyla::io::write<tinyla::mat4f>(path, ms));
+
+    auto const mapped = tinyla::io::mapped_array<tinyla::mat4f>::open(path);
+    REQUIRE(mapped.has_value());
+    REQUIRE(mapped->size() == ms.size());
+    REQUIRE(mapped->header().kind == tinyla::io::kind::mat);
+    REQUIRE(mapped->header().n == 4);
+    REQUIRE(mapped->header().data_offset % tinyla::io::default_alignment == 0);
+
+    auto const elements = mapped->elements();
+    REQUIRE(reinterpret_cast<std::uintptr_t>(elements.data()) % tinyla::io::default_alignment == 0);
+    for (std::size_t i = 0; i < ms.size(); ++i) {
+        CAPTURE(i);
+        compare(elements[i], ms[i]);
+    }
+
+    auto reopened = tinyla::io::mapped_array<tinyla::mat4f>::open(path);
+    REQUIRE(reopened.has_value());
+    *reopened = std::move(*tinyla::io::mapped_array<tinyla::mat4f>::open(path));
+    REQUIRE(reopened->size() == ms.size());
+    compare(reopened->elements()[0], unique);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("io writes and maps SoA vec3 arrays", "[io]")
+{
+    auto const path = temp_file("tinyla_io_tests_vec3.bin");
+    auto const points = make_points(5000);
+    REQUIRE(!tinyla::io::write<tinyla::vec3f>(path, points, tinyla::io::layout::soa, 32));
+
+    auto const mapped = tinyla::io::mapped_array<tinyla::vec3f>::open(path);
+    REQUIRE(mapped.has_value());
+    REQUIRE(mapped->size() == points.size());
+    for (std::size_t c = 0; c < 3; ++c) {
+        auto const component = mapped->component(c);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(component.data()) % 32 == 0);
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            if (component[i] != points[i][c]) {
+                CAPTURE(c, i);
+                REQUIRE(component[i] == points[i][c]);
+            }
+        }
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("io rejects mismatching element types", "[io]")
+{
+    auto const path = temp_file("tinyla_io_tests_mismatch.bin");
+    REQUIRE(!tinyla::io::write<tinyla::vec3f>(path, make_points(3)));
+
+    REQUIRE(tinyla::io::mapped_array<tinyla::vec3f>::open(path).has_value());
+    REQUIRE(!tinyla::io::mapped_array<tinyla::vec4f>::open(path).has_value());
+    REQUIRE(!tinyla::io::mapped_array<tinyla::vec<3, double>>::open(path).has_value());
+    REQUIRE(!tinyla::io::mapped_array<tinyla::mat3f>::open(path).has_value());
+    std::filesystem::remove(path);
+
+    REQUIRE(tinyla::io::mapped_array<tinyla::vec3f>::open(path).error() == std::errc::no_such_file_or_directory);
+}
+
+TEST_CASE("io rejects truncated files", "[io]")
+{
+    auto const path = temp_file("tinyla_io_tests_truncated.bin");
+    REQUIRE(!tinyla::io::write<tinyla::vec3f>(path, make_points(100)));
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    REQUIRE(!tinyla::io::mapped_array<tinyla::vec3f>::open(path).has_value());
+    std::filesystem::remove(path);
+}
+
+static void patch_header(std::filesystem::path const& path, tinyla::io::header const& header)
+{
+    auto file = std::fstream{path, std::ios::binary | std::ios::in | std::ios::out};
+    file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+}
+
+TEST_CASE("io rejects corrupt counts and data offsets", "[io]")
+{
+    auto const path = temp_file("tinyla_io_tests_corrupt.bin");
+    auto const vectors = std::vector<tinyla::vec4f>(4, tinyla::vec4f{1.0f, 2.0f, 3.0f, 4.0f});
+
+    for (auto layout : {tinyla::io::layout::aos, tinyla::io::layout::soa}) {
+        REQUIRE(!tinyla::io::write<tinyla::vec4f>(path, vectors, layout));
+        auto const valid = tinyla::io::mapped_array<tinyla::vec4f>::open(path);
+        REQUIRE(valid.has_value());
+        auto const header = valid->header();
+
+        // Wraps around to 16 bytes of data when multiplied by sizeof(vec4f).
+        auto corrupt = header;
+        corrupt.count = (std::uint64_t{1} << 60) + 1;
+        patch_header(path, corrupt);
+        REQUIRE(!tinyla::io::mapped_array<tinyla::vec4f>::open(path).has_value());
+
+        corrupt = header;
+        corrupt.data_offset = 0;
+        patch_header(path, corrupt);
+        REQUIRE(!tinyla::io::mapped_array<tinyla::vec4f>::open(path).has_value());
+
+        corrupt = header;
+        corrupt.data_offset = header.data_offset + (std::uint64_t{1} << 40);
+        patch_header(path, corrupt);
+        REQUIRE(!tinyla::io::mapped_array<tinyla::vec4f>::open(path).has_value());
+    }
+
+    std::filesystem::remove(path);
+}
+
+int main(int argc, const char* argv[])
+{
+    return Catch::Session().run(argc, argv);
+}
@@ -0,0 +1,107 @@
+#include <tinyla/kdtree.hpp>
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch_all.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+static std::vector<tinyla::vec3f> make_points(std::size_t count, std::uint64_t seed)
+{
+    auto next = [&seed] {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        return static_cast<float>(seed >> 40) / static_cast<float>(1 << 24);
+    };
+    auto points = std::vector<tinyla::vec3f>{};
+    for (std::size_t i = 0; i < count; ++i) {
+        auto const x = next();
+        auto const y = next();
+        auto const z = next();
+        points.emplace_back(10.0f * x, 10.0f * y, z);
+    }
+    return points;
+}
+
+static std::vector<tinyla::neighbor<float>> brute_force(std::vector<tinyla::vec3f> const& points,
+                                                        tinyla::vec3f const& query)
+{
+    auto all = std::vector<tinyla::neighbor<float>>{};
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        all.push_back({static_cast<std::uint32_t>(i), (points[i] - query).length_squared()});
+    }
+    std::sort(all.begin(), all.end(), tinyla::detail::closer<float>);
+    return all;
+}
+
+TEST_CASE("kdtree k nearest neighbours", "[kdtree]")
+{
+    auto const points = make_points(5000, 1);
+    auto const tree = tinyla::kdtree<float>{points, 8};
+    REQUIRE(tree.size() == points.size());
+
+    auto const queries = make_points(50, 2);
+    auto result = std::vector<tinyla::neighbor<float>>(10, tinyla::neighbor<float>{0, 0.0f});
+    for (auto const& q : queries) {
+        REQUIRE(tree.nearest(q, result) == result.size());
+        auto const expected = brute_force(points, q);
+        for (std::size_t i = 0; i < result.size(); ++i) {
+            REQUIRE(result[i].index == expected[i].index);
+            REQUIRE(result[i].distance_squared == expected[i].distance_squared);
+        }
+    }
+}
+
+TEST_CASE("kdtree batched nearest", "[kdtree]")
+{
+    auto const points = make_points(1000, 3);
+    auto const tree = tinyla::kdtree<float>{points};
+    auto const queries = make_points(700, 4);
+
+    constexpr std::size_t k = 4;
+    auto results = std::vector<tinyla::neighbor<float>>(queries.size() * k, tinyla::neighbor<float>{0, 0.0f});
+    tree.nearest(queries, k, results);
+    for (std::size_t i = 0; i < queries.size(); ++i) {
+        auto const expected = brute_force(points, queries[i]);
+        for (std::size_t j = 0; j < k; ++j) REQUIRE(results[i * k + j].index == expected[j].index);
+    }
+
+    auto const small = tinyla::kdtree<float>{std::span<const tinyla::vec3f>{points}.first(2)};
+    auto padded = std::vector<tinyla::neighbor<float>>(k, tinyla::neighbor<float>{0, 0.0f});
+    small.nearest(std::span<const tinyla::vec3f>{queries}.first(1), k, padded);
+    REQUIRE(padded[1].index != tinyla::kdtree<float>::npos);
+    REQUIRE(padded[2].index == tinyla::kdtree<float>::npos);
+    REQUIRE(padded[3].index == tinyla::kdtree<float>::npos);
+}
+
+TEST_CASE("kdtree radius search", "[kdtree]")
+{
+    auto const points = make_points(3000, 5);
+    auto const tree = tinyla::kdtree<float>{points, 4, tinyla::parallel::options{.threads = 3}};
+
+    auto result = std::vector<tinyla::neighbor<float>>{};
+    for (auto const& q : make_points(30, 6)) {
+        auto const count = tree.within(q, 0.75f, result);
+        auto const expected = brute_force(points, q);
+        auto const inside = std::count_if(expected.begin(), expected.end(),
+            [](auto const& n) { return n.distance_squared <= 0.75f * 0.75f; });
+        REQUIRE(count == static_cast<std::size_t>(inside));
+        std::sort(result.begin(), result.end(), tinyla::detail::closer<float>);
+        for (std::size_t i = 0; i < count; ++i) REQUIRE(result[i].index == expected[i].index);
+    }
+}
+
+TEST_CASE("kdtree with duplicate and few points", "[kdtree]")
+{
+    auto const same = std::vector<tinyla::vec3f>(100, tinyla::vec3f{1.0f, 2.0f, 3.0f});
+    auto const tree = tinyla::kdtree<float>{same, 3};
+    auto result = std::vector<tinyla::neighbor<float>>(5, tinyla::neighbor<float>{0, 0.0f});
+    REQUIRE(tree.nearest(tinyla::vec3f{0.0f, 0.0f, 0.0f}, result) == 5);
+    for (std::size_t i = 0; i < result.size(); ++i) REQUIRE(result[i].index == i);
+
+    auto const empty = tinyla::kdtree<float>{std::span<const tinyla::vec3f>{}};
+    REQUIRE(empty.nearest(tinyla::vec3f{0.0f, 0.0f, 0.0f}, result) == 0);
+}
+
+int main(int argc, const char* argv[])
+{
+    return Catch::Session().run(argc, argv);
+}
@@ -189,6 +189,57 @@ TEST_CASE("mat4 * vec4", "[mat4]")
     compare(mv, tinyla::vec4i{30, 70, 110, 150});
 }
 
+TEST_CASE("rectangular matrices", "[mat]")
+{
+    constexpr auto a = tinyla::mat2x3f {
+        1.0f, 2.0f, 3.0f,
+        4.0f, 5.0f, 6.0f
+    };
+    static_assert(a.rows == 2 && a.columns == 3);
+    REQUIRE(a[0, 2] == 3.0f);
+    REQUIRE(a[1, 0] == 4.0f);
+    REQUIRE(a.data()[1] == 4.0f);
+
+    constexpr auto t = a.transposed();
+    static_assert(std::is_same_v<decltype(t), const tinyla::matrix<3,2,float>>);
+    compare(t, tinyla::matrix<3,2,float>{
+        1.0f, 4.0f,
+        2.0f, 5.0f,
+        3.0f, 6.0f
+    });
+    compare(t.transposed(), a);
+
+    // (2x3) * (3x2) = 2x2
+    constexpr auto p = a * t;
+    static_assert(std::is_same_v<decltype(p), const tinyla::mat2f>);
+    compare(p, tinyla::mat2f{
+        14.0f, 32.0f,
+        32.0f, 77.0f
+    });
+
+    constexpr auto v = a * tinyla::vec3f{1.0f, 0.0f, -1.0f};
+    compare(v, tinyla::vec2f{-2.0f, -2.0f});
+
+    constexpr auto i = tinyla::mat3x4f{tinyla::mat_init::identity};
+    REQUIRE(i[2, 2] == 1.0f);
+    REQUIRE(i[2, 3] == 0.0f);
+    compare(i * unique, tinyla::mat3x4f{
+        1.0f, 2.0f, 3.0f, 4.0f,
+        5.0f, 6.0f, 7.0f, 8.0f,
+        9.0f, 10.0f, 11.0f, 12.0f
+    });
+}
+
+TEST_CASE("mat4 transposed", "[mat4]")
+{
+    constexpr auto t = unique.transposed();
+    for (std::size_t i = 0; i < 4; ++i) {
+        for (std::size_t j = 0; j < 4; ++j) {
+            REQUIRE(t[i, j] == unique[j, i]);
+        }
+    }
+}
+
 int main(int argc, const char* argv[])
 {
     return Catch::Session().run(argc, argv);
@@ -0,0 +1,103 @@
+#include <tinyla/matx.hpp>
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch_all.hpp>
+#include "compare.hpp"
+#include "data.hpp"
+#include <cstdint>
+#include <vector>
+
+template<typename T>
+static tinyla::matx<T> make_matrix(std::size_t rows, std::size_t columns, std::uint64_t seed)
+{
+    auto m = tinyla::matx<T>{rows, columns, tinyla::mat_init::uninitialized};
+    for (std::size_t j = 0; j < columns; ++j) {
+        for (std::size_t i = 0; i < rows; ++i) {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            m[i, j] = static_cast<T>(static_cast<double>(seed >> 40) / static_cast<double>(1 << 24) - 0.5);
+        }
+    }
+    return m;
+}
+
+template<typename T>
+static tinyla::matx<T> naive_product(tinyla::matx<T> const& a, tinyla::matx<T> const& b)
+{
+    auto c = tinyla::matx<T>{a.rows(), b.columns()};
+    for (std::size_t i = 0; i < a.rows(); ++i) {
+        for (std::size_t j = 0; j < b.columns(); ++j) {
+            for (std::size_t k = 0; k < a.columns(); ++k) c[i, j] += a[i, k] * b[k, j];
+        }
+    }
+    return c;
+}
+
+TEST_CASE("matx construction and mat interop", "[matx]")
+{
+    auto const i = tinyla::matx<float>{3, 5, tinyla::mat_init::identity};
+    REQUIRE(i.rows() == 3);
+    REQUIRE(i.columns() == 5);
+    REQUIRE(i[2, 2] == 1.0f);
+    REQUIRE(i[2, 3] == 0.0f);
+
+    auto const u = tinyla::matx<float>{unique};
+    REQUIRE(u[0, 1] == unique[0, 1]);
+    REQUIRE(u[3, 0] == unique[3, 0]);
+    compare(u.to_mat<4>(), unique);
+
+    auto const v = tinyla::view(unique).block(1, 2, 2, 2);
+    REQUIRE(v[0, 0] == unique[1, 2]);
+    REQUIRE(v[1, 1] == unique[2, 3]);
+}
+
+TEMPLATE_TEST_CASE("matx gemm", "[matx]", float, double)
+{
+    // Sizes straddle the micro-kernel and cache block boundaries.
+    for (auto const [m, k, n] : {std::array<std::size_t, 3>{1, 1, 1}, {7, 3, 5}, {67, 300, 131}, {257, 33, 9}}) {
+        auto const a = make_matrix<TestType>(m, k, 1);
+        auto const b = make_matrix<TestType>(k, n, 2);
+        auto const expected = naive_product(a, b);
+
+        auto c = make_matrix<TestType>(m, n, 3);
+        auto const c0 = c;
+        tinyla::gemm(TestType{2}, a.view(), b.view(), TestType{0.5}, c.view(), tinyla::parallel::options{.threads = 3});
+        for (std::size_t i = 0; i < m; ++i) {
+            for (std::size_t j = 0; j < n; ++j) {
+                REQUIRE(c[i, j] == Catch::Approx(2 * expected[i, j] + c0[i, j] / 2).margin(1e-4));
+            }
+        }
+
+        auto const p = a * b;
+        auto const serial = [&] {
+            auto r = tinyla::matx<TestType>{m, n};
+            tinyla::gemm(TestType{1}, a.view(), b.view(), TestType{0}, r.view(), tinyla::parallel::options{.threads = 1});
+            return r;
+        }();
+        for (std::size_t i = 0; i < m; ++i) {
+            for (std::size_t j = 0; j < n; ++j) REQUIRE(p[i, j] == serial[i, j]);
+        }
+    }
+}
+
+TEST_CASE("matx gemm on mat views", "[matx]")
+{
+    auto c = tinyla::mat4f{tinyla::mat_init::zero};
+    tinyla::gemm(1.0f, tinyla::view(unique), tinyla::view(unique), 0.0f, tinyla::view(c));
+    compare(c, unique * unique);
+}
+
+TEMPLATE_TEST_CASE("matx gemv", "[matx]", float, double)
+{
+    auto const a = make_matrix<TestType>(1100, 70, 4);
+    auto const xm = make_matrix<TestType>(70, 1, 5);
+    auto const x = std::vector<TestType>(xm.data(), xm.data() + 70);
+    auto y = std::vector<TestType>(1100, TestType{1});
+
+    tinyla::gemv(TestType{1}, a.view(), x, TestType{-1}, y);
+    auto const expected = naive_product(a, xm);
+    for (std::size_t i = 0; i < y.size(); ++i) REQUIRE(y[i] == Catch::Approx(expected[i, 0] - 1).margin(1e-4));
+}
+
+int main(int argc, const char* argv[])
+{
+    return Catch::Session().run(argc, argv);
+}
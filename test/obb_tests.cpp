@@ -0,0 +1,194 @@
+#include <tinyla/obb.hpp>
+#include <tinyla/geom.hpp>
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch_all.hpp>
+#include "compare.hpp"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+template<typename T>
+static T next(std::uint64_t& seed)
+{
+    seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+    return static_cast<T>(static_cast<double>(seed >> 40) / static_cast<double>(1 << 24) * 2.0 - 1.0);
+}
+
+// A random rotation, taken from the eigenvectors of a random symmetric matrix.
+template<typename T>
+static tinyla::mat<3,T> random_rotation(std::uint64_t& seed)
+{
+    auto a = tinyla::mat<3,T>{tinyla::mat_init::zero};
+    for (std::size_t i = 0; i < 3; ++i) {
+        for (std::size_t j = 0; j <= i; ++j) a[i, j] = a[j, i] = next<T>(seed);
+    }
+    return tinyla::symmetric_eigen(a).vectors;
+}
+
+template<typename T>
+static tinyla::geom::obb<T> random_box(std::uint64_t& seed, T spread)
+{
+    auto const center = tinyla::vec<3,T>{next<T>(seed) * spread, next<T>(seed) * spread, next<T>(seed) * spread};
+    auto const extents = tinyla::vec<3,T>{
+        T{0.1} + tinyla::abs(next<T>(seed)), T{0.1} + tinyla::abs(next<T>(seed)), T{0.1} + tinyla::abs(next<T>(seed))};
+    return {center, random_rotation<T>(seed), extents};
+}
+
+template<typename T>
+static tinyla::vec<3,T> to_local(tinyla::geom::obb<T> const& box, tinyla::vec<3,T> const& p)
+{
+    return box.axes.transposed() * (p - box.center);
+}
+
+template<typename T>
+static tinyla::vec<3,T> transform_point(tinyla::mat<4,T> const& m, tinyla::vec<3,T> const& p)
+{
+    auto const q = m * tinyla::vec<4,T>{p.x(), p.y(), p.z(), T{1}};
+    return {q.x(), q.y(), q.z()};
+}
+
+template<typename T>
+static std::array<T,3> as_array(tinyla::vec<3,T> const& v)
+{
+    return {v.x(), v.y(), v.z()};
+}
+
+template<typename T>
+static bool contains(tinyla::geom::obb<T> const& box, tinyla::vec<3,T> const& p, T margin)
+{
+    auto const q = to_local(box, p);
+    for (std::size_t c = 0; c < 3; ++c) {
+        if (tinyla::abs(q[c]) > box.extents[c] + margin) return false;
+    }
+    return true;
+}
+
+TEMPLATE_TEST_CASE("obb from points", "[obb]", float, double)
+{
+    constexpr auto margin = std::is_same_v<TestType, float> ? TestType{1e-4} : TestType{1e-10};
+    std::uint64_t seed = 3;
+    auto const rotation = random_rotation<TestType>(seed);
+    auto const center = tinyla::vec<3,TestType>{1, -2, 3};
+    auto const half = tinyla::vec<3,TestType>{4, 2, 1};
+
+    // Points filling a box, including its corners, so the fitted box is that box.
+    auto points = std::vector<tinyla::vec<3,TestType>>{};
+    for (std::size_t i = 0; i < 20000; ++i) {
+        auto const local = tinyla::vec<3,TestType>{next<TestType>(seed), next<TestType>(seed), next<TestType>(seed)} * half;
+        points.push_back(rotation * local + center);
+    }
+    for (int corner = 0; corner < 8; ++corner) {
+        auto const local = tinyla::vec<3,TestType>{
+            corner & 1 ? half.x() : -half.x(), corner & 2 ? half.y() : -half.y(), corner & 4 ? half.z() : -half.z()};
+        points.push_back(rotation * local + center);
+    }
+
+    auto const box = tinyla::geom::fit_obb(std::span<const tinyla::vec<3,TestType>>{points});
+    constexpr auto tolerance = TestType{0.05};
+    REQUIRE(tinyla::abs(box.center.x() - center.x()) < tolerance);
+    REQUIRE(tinyla::abs(box.center.y() - center.y()) < tolerance);
+    REQUIRE(tinyla::abs(box.center.z() - center.z()) < tolerance);
+    // Eigenvalues are sorted descending, so the axes come out longest first.
+    REQUIRE(box.extents.x() == Catch::Approx(half.x()).margin(tolerance));
+    REQUIRE(box.extents.y() == Catch::Approx(half.y()).margin(tolerance));
+    REQUIRE(box.extents.z() == Catch::Approx(half.z()).margin(tolerance));
+    compare(box.axes.transposed() * box.axes, tinyla::mat<3,TestType>{tinyla::mat_init::identity}, margin);
+    for (auto const& p : points) REQUIRE(contains(box, p, margin * 10));
+}
+
+TEMPLATE_TEST_CASE("obb transform", "[obb]", float, double)
+{
+    constexpr auto margin = std::is_same_v<TestType, float> ? TestType{1e-4} : TestType{1e-10};
+    std::uint64_t seed = 5;
+    auto const box = random_box<TestType>(seed, TestType{2});
+    auto const axis = tinyla::vec<3,TestType>{1, 2, 3}.normalized();
+    auto const angle = tinyla::geom::angle<TestType>::from_degrees(TestType{40});
+
+    // A rigid motion maps the box exactly.
+    auto const rigid = tinyla::geom::translation(tinyla::vec<3,TestType>{1, 2, 3}) * tinyla::geom::rotation(angle, axis);
+    auto const moved = tinyla::geom::transformed(box, rigid);
+    compare(moved.extents, as_array(box.extents), margin);
+    compare(moved.center, as_array(transform_point(rigid, box.center)), margin);
+
+    // Any affine map: the image of every corner stays inside the result.
+    auto sheared = rigid;
+    sheared[0, 1] = TestType{0.5};
+    sheared[2, 0] = TestType{-0.3};
+    for (auto const& m : {rigid, sheared}) {
+        auto const image = tinyla::geom::transformed(box, m);
+        compare(image.axes.transposed() * image.axes, tinyla::mat<3,TestType>{tinyla::mat_init::identity}, margin);
+        for (int corner = 0; corner < 8; ++corner) {
+            auto const local = tinyla::vec<3,TestType>{
+                corner & 1 ? box.extents.x() : -box.extents.x(),
+                corner & 2 ? box.extents.y() : -box.extents.y(),
+                corner & 4 ? box.extents.z() : -box.extents.z()};
+            auto const p = box.axes * local + box.center;
+            REQUIRE(contains(image, transform_point(m, p), margin * 10));
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE("obb overlap", "[obb]", float, double)
+{
+    using obb = tinyla::geom::obb<TestType>;
+    auto const identity = tinyla::mat<3,TestType>{tinyla::mat_init::identity};
+    auto const unit = tinyla::vec<3,TestType>{1, 1, 1};
+    auto const a = obb{tinyla::vec<3,TestType>{tinyla::vec_init::zero}, identity, unit};
+
+    REQUIRE(tinyla::geom::overlaps(a, a));
+    REQUIRE(tinyla::geom::overlaps(a, obb{tinyla::vec<3,TestType>{1.9, 0, 0}, identity, unit}));
+    REQUIRE_FALSE(tinyla::geom::overlaps(a, obb{tinyla::vec<3,TestType>{2.1, 0, 0}, identity, unit}));
+
+    // Rotated 45 degrees about z: the corner reaches out to sqrt(2).
+    auto const z45 = tinyla::geom::rotation(tinyla::geom::angle<TestType>::from_degrees(45), tinyla::vec<3,TestType>{0, 0, 1});
+    auto r = identity;
+    for (std::size_t i = 0; i < 3; ++i) {
+        for (std::size_t j = 0; j < 3; ++j) r[i, j] = z45[i, j];
+    }
+    REQUIRE(tinyla::geom::overlaps(a, obb{tinyla::vec<3,TestType>{2.3, 0, 0}, r, unit}));
+    REQUIRE_FALSE(tinyla::geom::overlaps(a, obb{tinyla::vec<3,TestType>{2.5, 0, 0}, r, unit}));
+
+    // Two boxes rotated 45 degrees about different axes, separated only by the cross product of two edges.
+    auto const x45 = tinyla::geom::rotation(tinyla::geom::angle<TestType>::from_degrees(45), tinyla::vec<3,TestType>{1, 0, 0});
+    auto s = identity;
+    for (std::size_t i = 0; i < 3; ++i) {
+        for (std::size_t j = 0; j < 3; ++j) s[i, j] = x45[i, j];
+    }
+    // Along y, the axis of a's z edges crossed with b's x edges, both boxes reach out to sqrt(2).
+    auto const reach = 2 * tinyla::sqrt(TestType{2});
+    auto const edge_a = obb{tinyla::vec<3,TestType>{tinyla::vec_init::zero}, r, unit};
+    REQUIRE(tinyla::geom::overlaps(edge_a, obb{tinyla::vec<3,TestType>{0, reach - TestType{0.1}, 0}, s, unit}));
+    REQUIRE_FALSE(tinyla::geom::overlaps(edge_a, obb{tinyla::vec<3,TestType>{0, reach + TestType{0.1}, 0}, s, unit}));
+}
+
+TEMPLATE_TEST_CASE("obb batched overlap", "[obb]", float, double)
+{
+    std::uint64_t seed = 7;
+    auto const a = random_box<TestType>(seed, TestType{0});
+    auto others = std::vector<tinyla::geom::obb<TestType>>{};
+    // Not a multiple of the lane count, so the last lanes are partly unused.
+    for (std::size_t i = 0; i < 2003; ++i) others.push_back(random_box<TestType>(seed, TestType{4}));
+
+    auto out = std::make_unique<bool[]>(others.size());
+    auto const count = tinyla::geom::overlaps(a, std::span<const tinyla::geom::obb<TestType>>{others},
+                                              std::span<bool>{out.get(), others.size()});
+    std::size_t expected = 0;
+    for (std::size_t i = 0; i < others.size(); ++i) {
+        REQUIRE(out[i] == tinyla::geom::overlaps(a, others[i]));
+        REQUIRE(out[i] == tinyla::geom::overlaps(others[i], a));
+        // Boxes whose bounding spheres are apart never overlap; a centre inside the other box always does.
+        auto const distance = (others[i].center - a.center).length();
+        if (distance > a.extents.length() + others[i].extents.length()) REQUIRE_FALSE(out[i]);
+        if (contains(a, others[i].center, TestType{0})) REQUIRE(out[i]);
+        expected += out[i] ? 1 : 0;
+    }
+    REQUIRE(count == expected);
+    REQUIRE(count > 0);
+    REQUIRE(count < others.size());
+}
+
+int main(int argc, const char* argv[])
+{
+    return Catch::Session().run(argc, argv);
+}
@@ -0,0 +1,215 @@
+#ifndef TINYLA_TEST_PERF_COUNTERS_HPP
+#define TINYLA_TEST_PERF_COUNTERS_HPP
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <string>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+* Hardware performance counters read with Linux perf_event_open around benchmark bodies.
+* Every event is opened on its own for the calling thread and the threads it starts afterwards, in user space only
+* (which perf_event_paranoid <= 2 permits), and is scaled by its running time when the kernel multiplexes it.
+* Events the CPU or the kernel does not offer are reported as n/a; on other systems all of them are.
+*/
+namespace perf {
+    enum class event : std::size_t {
+        cycles,
+        instructions,
+        cache_misses,
+        branch_misses,
+        vector_instructions,
+        count
+    };
+
+    constexpr std::size_t event_count = static_cast<std::size_t>(event::count);
+
+    using counts = std::array<std::optional<double>, event_count>;
+
+    /**
+    * Raw event code counting vector instructions, for which perf has no generic event: FP_ARITH_INST_RETIRED
+    * with all packed umasks on Intel (Broadwell and later; an FMA counts twice), none elsewhere.
+    */
+    inline std::optional<std::uint64_t> default_vector_event()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        if (__builtin_cpu_is("intel")) return 0xfcc7;
+#endif
+        return std::nullopt;
+    }
+
+    class counters {
+    public:
+        explicit counters(std::optional<std::uint64_t> vector_event = default_vector_event());
+        ~counters();
+
+        counters(counters const&) = delete;
+        counters& operator=(counters const&) = delete;
+
+        // Whether at least one event could be opened.
+        bool available() const;
+
+        void start();
+        counts stop();
+    private:
+        std::array<int, event_count> m_fds;
+    };
+
+    // Calls f in doubling batches until one batch takes at least min_time and returns the size of that batch.
+    template<typename F>
+    std::size_t calls_taking(F&& f, std::chrono::nanoseconds min_time);
+
+    // Counts per call of f, called calls_taking(f, min_time) times with the counters running.
+    template<typename F>
+    counts per_call(counters& counters, F&& f,
+                    std::chrono::nanoseconds min_time = std::chrono::milliseconds{50});
+
+    // Prints the counts per call and per element, and the instructions per cycle.
+    void report(std::string const& name, std::size_t elements, counts const& counts);
+
+    namespace detail {
+#ifdef __linux__
+        inline int open(std::uint32_t type, std::uint64_t config)
+        {
+            auto attr = perf_event_attr{};
+            attr.size = sizeof(attr);
+            attr.type = type;
+            attr.config = config;
+            attr.disabled = 1;
+            attr.inherit = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+#endif
+    }
+
+    inline counters::counters([[maybe_unused]] std::optional<std::uint64_t> vector_event)
+    {
+        m_fds.fill(-1);
+#ifdef __linux__
+        m_fds[static_cast<std::size_t>(event::cycles)] =
+            detail::open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        m_fds[static_cast<std::size_t>(event::instructions)] =
+            detail::open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        m_fds[static_cast<std::size_t>(event::cache_misses)] =
+            detail::open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+        m_fds[static_cast<std::size_t>(event::branch_misses)] =
+            detail::open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+        if (vector_event) {
+            m_fds[static_cast<std::size_t>(event::vector_instructions)] = detail::open(PERF_TYPE_RAW, *vector_event);
+        }
+#endif
+    }
+
+    inline counters::~counters()
+    {
+#ifdef __linux__
+        for (auto const fd : m_fds) {
+            if (fd >= 0) close(fd);
+        }
+#endif
+    }
+
+    inline bool counters::available() const
+    {
+        for (auto const fd : m_fds) {
+            if (fd >= 0) return true;
+        }
+        return false;
+    }
+
+    inline void counters::start()
+    {
+#ifdef __linux__
+        for (auto const fd : m_fds) {
+            if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        }
+        for (auto const fd : m_fds) {
+            if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    inline counts counters::stop()
+    {
+        auto result = counts{};
+#ifdef __linux__
+        for (auto const fd : m_fds) {
+            if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+        for (std::size_t e = 0; e < event_count; ++e) {
+            // value, time enabled, time running
+            std::uint64_t values[3];
+            if (m_fds[e] < 0 || read(m_fds[e], values, sizeof(values)) != sizeof(values) || values[2] == 0) continue;
+            result[e] = static_cast<double>(values[0]) * static_cast<double>(values[1]) / static_cast<double>(values[2]);
+        }
+#endif
+        return result;
+    }
+
+    template<typename F>
+    std::size_t calls_taking(F&& f, std::chrono::nanoseconds min_time)
+    {
+        using clock = std::chrono::steady_clock;
+
+        auto calls = std::size_t{1};
+        for (;;) {
+            auto const start = clock::now();
+            for (std::size_t i = 0; i < calls; ++i) f();
+            if (clock::now() - start >= min_time) return calls;
+            calls *= 2;
+        }
+    }
+
+    template<typename F>
+    counts per_call(counters& counters, F&& f, std::chrono::nanoseconds min_time)
+    {
+        auto const calls = calls_taking(f, min_time);
+
+        counters.start();
+        for (std::size_t i = 0; i < calls; ++i) f();
+        auto result = counters.stop();
+        for (auto& count : result) {
+            if (count) *count /= static_cast<double>(calls);
+        }
+        return result;
+    }
+
+    inline void report(std::string const& name, std::size_t elements, counts const& counts)
+    {
+        constexpr char const* names[event_count] = {
+            "cycles", "instructions", "cache misses", "branch misses", "vector instructions"
+        };
+
+        auto const& cycles = counts[static_cast<std::size_t>(event::cycles)];
+        auto const& instructions = counts[static_cast<std::size_t>(event::instructions)];
+        std::printf("\n%s\n", name.c_str());
+        if (cycles && instructions && *cycles > 0.0) {
+            std::printf("  %-20s %14.2f\n", "IPC", *instructions / *cycles);
+        } else {
+            std::printf("  %-20s %14s\n", "IPC", "n/a");
+        }
+        std::printf("  %-20s %14s %14s\n", "", "per call", "per element");
+        for (std::size_t e = 0; e < event_count; ++e) {
+            if (counts[e]) {
+                std::printf("  %-20s %14.2f %14.4f\n", names[e], *counts[e], *counts[e] / static_cast<double>(elements));
+            } else {
+                std::printf("  %-20s %14s %14s\n", names[e], "n/a", "n/a");
+            }
+        }
+    }
+}
+
+#endif // TINYLA_TEST_PERF_COUNTERS_HPP
@@ -0,0 +1,91 @@
+#include <tinyla/reduce.hpp>
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch_all.hpp>
+#include "compare.hpp"
+#include <vector>
+
+static std::vector<tinyla::vec3f> make_points(std::size_t count)
+{
+    auto points = std::vector<tinyla::vec3f>{};
+    for (std::size_t i = 0; i < count; ++i) {
+        auto const t = static_cast<float>(i) / static_cast<float>(count);
+        points.emplace_back(10.0f + t, 2.0f * t - 5.0f, float(i % 7) * 0.1f);
+    }
+    return points;
+}
+
+TEST_CASE("vec3 bounds", "[vec3]")
+{
+    auto const points = std::vector<tinyla::vec3f>{
+        tinyla::vec3f{1.0f, -2.0f, 3.0f},
+        tinyla::vec3f{-1.0f, 5.0f, 0.0f},
+        tinyla::vec3f{0.0f, 0.0f, 7.0f}
+    };
+    auto const b = tinyla::bounds(std::span<const tinyla::vec3f>{points});
+    compare(b.min, tinyla::vec3f{-1.0f, -2.0f, 0.0f});
+    compare(b.max, tinyla::vec3f{1.0f, 5.0f, 7.0f});
+
+    auto const large = make_points(100000);
+    auto const lb = tinyla::bounds(std::span<const tinyla::vec3f>{large});
+    compare(lb.min, tinyla::vec3f{10.0f, -5.0f, 0.0f});
+    compare(lb.max, tinyla::vec3f{large.back().x(), large.back().y(), 0.6f});
+}
+
+TEST_CASE("vec3 sum and mean", "[vec3]")
+{
+    auto const points = std::vector<tinyla::vec3i>{
+        tinyla::vec3i{1, 2, 3},
+        tinyla::vec3i{4, 5, 6},
+        tinyla::vec3i{7, 8, 9}
+    };
+    compare(tinyla::sum(std::span<const tinyla::vec3i>{points}), tinyla::vec3i{12, 15, 18});
+    compare(tinyla::mean(std::span<const tinyla::vec3i>{points}), tinyla::vec3i{4, 5, 6});
+
+    // Pairwise summation keeps the error of a million float additions small.
+    auto const tenths = std::vector<tinyla::vec2f>(1000000, tinyla::vec2f{0.1f, 1.0f});
+    auto const s = tinyla::sum(std::span<const tinyla::vec2f>{tenths});
+    REQUIRE(s.x() == Catch::Approx(100000.0).epsilon(1e-6));
+    REQUIRE(s.y() == 1000000.0f);
+}
+
+TEST_CASE("vec3 covariance", "[vec3]")
+{
+    auto const points = std::vector<tinyla::vec3d>{
+        tinyla::vec3d{1.0, 0.0, 0.0},
+        tinyla::vec3d{-1.0, 0.0, 0.0},
+        tinyla::vec3d{0.0, 2.0, 1.0},
+        tinyla::vec3d{0.0, -2.0, -1.0}
+    };
+    auto const c = tinyla::covariance(std::span<const tinyla::vec3d>{points});
+    compare(c, tinyla::mat<3, double>{
+        0.5, 0.0, 0.0,
+        0.0, 2.0, 1.0,
+        0.0, 1.0, 0.5
+    }, 1e-15);
+}
+
+TEST_CASE("vec3 reductions do not depend on the number of threads", "[vec3]")
+{
+    auto const points = make_points(123457);
+    auto const span = std::span<const tinyla::vec3f>{points};
+    auto const s = tinyla::sum(span, {1});
+    auto const m = tinyla::mean(span, {1});
+    auto const c = tinyla::covariance(span, {1});
+    for (std::size_t threads : {2, 3, 8, 64}) {
+        CAPTURE(threads);
+        auto const options = tinyla::parallel::options{threads};
+        auto const st = tinyla::sum(span, options);
+        auto const mt = tinyla::mean(span, options);
+        auto const ct = tinyla::covariance(span, options);
+        for (std::size_t i = 0; i < 3; ++i) {
+            REQUIRE(st[i] == s[i]);
+            REQUIRE(mt[i] == m[i]);
+            for (std::size_t j = 0; j < 3; ++j) REQUIRE(ct[i, j] == c[i, j]);
+        }
+    }
+}
+
+int main(int argc, const char* argv[])
+{
+    return Catch::Session().run(argc, argv);
+}
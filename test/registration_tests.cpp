@@ -0,0 +1,146 @@
+#include <tinyla/registration.hpp>
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch_all.hpp>
+#include "compare.hpp"
+#include <cstdint>
+#include <vector>
+
+template<typename T>
+static T next(std::uint64_t& seed)
+{
+    seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+    return static_cast<T>(static_cast<double>(seed >> 40) / static_cast<double>(1 << 24) * 2.0 - 1.0);
+}
+
+template<typename T>
+static std::vector<tinyla::vec<3,T>> make_points(std::size_t count, std::uint64_t seed, T spread)
+{
+    auto points = std::vector<tinyla::vec<3,T>>{};
+    for (std::size_t i = 0; i < count; ++i) {
+        points.push_back(tinyla::vec<3,T>{next<T>(seed) * spread, next<T>(seed) * spread, next<T>(seed) * spread});
+    }
+    return points;
+}
+
+template<typename T>
+static tinyla::vec<3,T> transform_point(tinyla::mat<4,T> const& m, tinyla::vec<3,T> const& p)
+{
+    auto const q = m * tinyla::vec<4,T>{p.x(), p.y(), p.z(), T{1}};
+    return {q.x(), q.y(), q.z()};
+}
+
+template<typename T>
+static std::vector<tinyla::vec<3,T>> transform_points(tinyla::mat<4,T> const& m, std::vector<tinyla::vec<3,T>> const& points)
+{
+    auto result = std::vector<tinyla::vec<3,T>>{};
+    for (auto const& p : points) result.push_back(transform_point(m, p));
+    return result;
+}
+
+template<typename T>
+static tinyla::mat<4,T> make_motion(T degrees, T scale)
+{
+    auto const axis = tinyla::vec<3,T>{T{0.3}, T{-0.5}, T{0.8}}.normalized();
+    return tinyla::geom::translation(tinyla::vec<3,T>{T{100}, T{-20}, T{5}})
+         * tinyla::geom::rotation(tinyla::geom::angle<T>::from_degrees(degrees), axis)
+         * tinyla::geom::scaling(tinyla::vec<3,T>{scale, scale, scale});
+}
+
+TEMPLATE_TEST_CASE("align recovers a rigid motion", "[registration]", float, double)
+{
+    constexpr auto margin = std::is_same_v<TestType, float> ? TestType{1e-3} : TestType{1e-9};
+    auto const source = make_points<TestType>(10000, 1, TestType{10});
+    auto const motion = make_motion<TestType>(TestType{70}, TestType{1});
+    auto const target = transform_points(motion, source);
+
+    auto const m = tinyla::geom::align(std::span<const tinyla::vec<3,TestType>>{source},
+                                       std::span<const tinyla::vec<3,TestType>>{target});
+    compare(m, motion, margin);
+
+    // Single-threaded and parallel passes agree.
+    auto const serial = tinyla::geom::align(std::span<const tinyla::vec<3,TestType>>{source},
+                                            std::span<const tinyla::vec<3,TestType>>{target},
+                                            tinyla::geom::registration::rigid, tinyla::parallel::options{.threads = 1});
+    compare(serial, m, margin);
+}
+
+TEMPLATE_TEST_CASE("align with scale and weights", "[registration]", float, double)
+{
+    constexpr auto margin = std::is_same_v<TestType, float> ? TestType{1e-3} : TestType{1e-9};
+    auto source = make_points<TestType>(5000, 2, TestType{10});
+    auto const motion = make_motion<TestType>(TestType{-130}, TestType{2.5});
+    auto target = transform_points(motion, source);
+
+    auto const m = tinyla::geom::align(std::span<const tinyla::vec<3,TestType>>{source},
+                                       std::span<const tinyla::vec<3,TestType>>{target},
+                                       tinyla::geom::registration::similarity);
+    compare(m, motion, margin);
+
+    // Outliers with weight zero leave the result unchanged.
+    auto weights = std::vector<TestType>(source.size(), TestType{1});
+    auto const outliers = make_points<TestType>(100, 3, TestType{1000});
+    for (auto const& p : outliers) {
+        source.push_back(p);
+        target.push_back(tinyla::vec<3,TestType>{p.z(), p.x(), p.y()});
+        weights.push_back(TestType{0});
+    }
+    auto const weighted = tinyla::geom::align(std::span<const tinyla::vec<3,TestType>>{source},
+                                              std::span<const tinyla::vec<3,TestType>>{target},
+                                              std::span<const TestType>{weights},
+                                              tinyla::geom::registration::similarity);
+    compare(weighted, motion, margin);
+}
+
+TEMPLATE_TEST_CASE("align never returns a reflection", "[registration]", float, double)
+{
+    constexpr auto margin = std::is_same_v<TestType, float> ? TestType{1e-4} : TestType{1e-10};
+    auto const source = make_points<TestType>(1000, 4, TestType{1});
+    auto const mirror = tinyla::geom::scaling(tinyla::vec<3,TestType>{-1, 1, 1});
+    auto const target = transform_points(mirror, source);
+
+    auto const m = tinyla::geom::align(std::span<const tinyla::vec<3,TestType>>{source},
+                                       std::span<const tinyla::vec<3,TestType>>{target});
+    auto const r = tinyla::geom::decompose(m).rotation;
+    compare(r.transposed() * r, tinyla::mat<3,TestType>{tinyla::mat_init::identity}, margin);
+    auto const det = r[0, 0] * (r[1, 1] * r[2, 2] - r[2, 1] * r[1, 2])
+                   - r[0, 1] * (r[1, 0] * r[2, 2] - r[2, 0] * r[1, 2])
+                   + r[0, 2] * (r[1, 0] * r[2, 1] - r[2, 0] * r[1, 1]);
+    REQUIRE(det == Catch::Approx(TestType{1}).margin(margin));
+}
+
+TEMPLATE_TEST_CASE("icp converges on a shuffled copy", "[registration]", float, double)
+{
+    constexpr auto margin = std::is_same_v<TestType, float> ? TestType{1e-3} : TestType{1e-8};
+    auto const target = make_points<TestType>(5000, 5, TestType{10});
+    // Source is the target moved back by a small motion, in a different order.
+    auto const motion = tinyla::geom::translation(tinyla::vec<3,TestType>{TestType{0.3}, TestType{-0.2}, TestType{0.1}})
+                      * tinyla::geom::rotation(tinyla::geom::angle<TestType>::from_degrees(TestType{4}),
+                                               tinyla::vec<3,TestType>{0, 0, 1});
+    auto const inverse = motion.inverted();
+    auto source = std::vector<tinyla::vec<3,TestType>>{};
+    for (std::size_t i = target.size(); i-- > 0;) source.push_back(transform_point(inverse, target[i]));
+
+    auto const tree = tinyla::kdtree<TestType>{std::span<const tinyla::vec<3,TestType>>{target}};
+    auto transform = tinyla::mat<4,TestType>{tinyla::mat_init::identity};
+    auto step = tinyla::geom::icp_result<TestType>{transform, TestType{0}, 0};
+    for (int i = 0; i < 50; ++i) {
+        step = tinyla::geom::icp_step(std::span<const tinyla::vec<3,TestType>>{source},
+                                      std::span<const tinyla::vec<3,TestType>>{target}, tree, transform, TestType{2});
+        transform = step.transform;
+    }
+    REQUIRE(step.inliers == source.size());
+    REQUIRE(step.rms < margin);
+    compare(transform, motion, margin * 10);
+
+    // No pair within the rejection distance: nothing to align.
+    auto const none = tinyla::geom::icp_step(std::span<const tinyla::vec<3,TestType>>{source},
+                                             std::span<const tinyla::vec<3,TestType>>{target}, tree,
+                                             tinyla::geom::translation(tinyla::vec<3,TestType>{1000, 0, 0}), TestType{1});
+    REQUIRE(none.inliers == 0);
+    compare(none.transform, tinyla::geom::translation(tinyla::vec<3,TestType>{1000, 0, 0}));
+}
+
+int main(int argc, const char* argv[])
+{
+    return Catch::Session().run(argc, argv);
+}
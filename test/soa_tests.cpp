@@ -0,0 +1,134 @@
+#include <tinyla/soa.hpp>
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch_all.hpp>
+#include "compare.hpp"
+#include "data.hpp"
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+template<typename T>
+static std::vector<tinyla::mat<4,T>> make_matrices(std::size_t count)
+{
+    auto matrices = std::vector<tinyla::mat<4,T>>(count, tinyla::mat<4,T>{tinyla::mat_init::zero});
+    for (std::size_t i = 0; i < count; ++i) {
+        for (std::size_t k = 0; k < 16; ++k) matrices[i].data()[k] = static_cast<T>(100 * i + k);
+    }
+    return matrices;
+}
+
+TEMPLATE_TEST_CASE("mat4 transposed by SIMD", "[mat4]", float, double)
+{
+    auto const m = make_matrices<TestType>(1)[0];
+    auto const t = m.transposed();
+    for (std::size_t i = 0; i < 4; ++i) {
+        for (std::size_t j = 0; j < 4; ++j) {
+            REQUIRE(t[i, j] == m[j, i]);
+        }
+    }
+    compare(t.transposed(), m);
+}
+
+TEMPLATE_TEST_CASE("mat4 AoS to SoA and back", "[mat4]", float, double)
+{
+    // Whole packs, a partial pack, and counts that are not a multiple of four.
+    for (std::size_t count : {std::size_t{0}, std::size_t{1}, std::size_t{7}, std::size_t{16}, std::size_t{21}}) {
+        auto const matrices = make_matrices<TestType>(count);
+        using pack = tinyla::mat4_pack<TestType>;
+        auto packs = std::vector<pack>(tinyla::pack_count<TestType>(count));
+        tinyla::to_soa<TestType, pack::lanes>(matrices, packs);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            auto const& p = packs[i / pack::lanes];
+            for (std::size_t k = 0; k < 16; ++k) {
+                REQUIRE(p.e[k][i % pack::lanes] == matrices[i].data()[k]);
+            }
+        }
+        for (std::size_t i = count; i < packs.size() * pack::lanes; ++i) {
+            compare(packs[i / pack::lanes].get(i % pack::lanes), tinyla::mat<4,TestType>{tinyla::mat_init::identity});
+        }
+
+        auto back = std::vector<tinyla::mat<4,TestType>>(count, tinyla::mat<4,TestType>{tinyla::mat_init::zero});
+        tinyla::from_soa<TestType, pack::lanes>(packs, back);
+        for (std::size_t i = 0; i < count; ++i) compare(back[i], matrices[i]);
+    }
+}
+
+TEST_CASE("mat4 pack with odd lane count", "[mat4]")
+{
+    auto const matrices = std::vector<tinyla::mat4f>{unique, identity, zero};
+    auto packs = std::vector<tinyla::mat4_pack<float, 3>>(1);
+    tinyla::to_soa<float, 3>(matrices, packs);
+    compare(packs[0].get(0), unique);
+    compare(packs[0].get(1), identity);
+
+    auto back = std::vector<tinyla::mat4f>(3, unique);
+    tinyla::from_soa<float, 3>(packs, back);
+    compare(back[2], zero);
+}
+
+TEMPLATE_TEST_CASE("vec4 pack swizzle selects component rows", "[vec4]", float, double)
+{
+    auto pack = tinyla::vec_pack<4,TestType>{};
+    for (std::size_t lane = 0; lane < pack.lanes; ++lane) {
+        auto const l = static_cast<TestType>(lane);
+        pack.set(lane, tinyla::vec<4,TestType>{l, 10 + l, 20 + l, 30 + l});
+    }
+
+    auto const zyx = pack.template swizzle<2, 1, 0>();
+    REQUIRE(zyx[0].data() == pack.e[2]);
+    REQUIRE(zyx[2].data() == pack.e[0]);
+    for (std::size_t lane = 0; lane < pack.lanes; ++lane) compare(zyx.get(lane), pack.get(lane).zyx());
+
+    // Writes through the view land in the pack.
+    for (auto& x : pack.template swizzle<0, 3>()[1]) x = TestType{-1};
+    for (std::size_t lane = 0; lane < pack.lanes; ++lane) REQUIRE(pack.get(lane).w() == TestType{-1});
+
+    auto const& const_pack = pack;
+    auto const xy = const_pack.template swizzle<0, 1>();
+    STATIC_REQUIRE(std::is_same_v<decltype(xy[0]), std::span<TestType const, tinyla::default_lanes<TestType>>>);
+    compare(xy.get(3), tinyla::vec<2,TestType>{3, 13});
+}
+
+TEMPLATE_TEST_CASE("mat4 packs inverted and determinant", "[mat4]", float, double)
+{
+    // Well-conditioned matrices in most lanes, singular ones in a few.
+    auto matrices = std::vector<tinyla::mat<4,TestType>>{};
+    for (std::size_t i = 0; i < 19; ++i) {
+        auto m = tinyla::mat<4,TestType>{tinyla::mat_init::identity};
+        for (std::size_t k = 0; k < 16; ++k) {
+            m.data()[k] += static_cast<TestType>(((i + 3) * (k + 5)) % 11) / TestType{10};
+        }
+        matrices.push_back(i % 7 == 3 ? unique.cast<TestType>() : m);
+    }
+
+    using pack = tinyla::mat4_pack<TestType>;
+    auto packs = std::vector<pack>(tinyla::pack_count<TestType>(matrices.size()));
+    tinyla::to_soa<TestType, pack::lanes>(matrices, packs);
+
+    auto determinants = std::vector<TestType>(packs.size() * pack::lanes);
+    tinyla::determinant<TestType, pack::lanes>(packs, determinants);
+
+    auto singular = std::make_unique<bool[]>(packs.size() * pack::lanes);
+    auto const flags = std::span<bool>{singular.get(), packs.size() * pack::lanes};
+    auto const count = tinyla::invert<TestType, pack::lanes>(packs, packs, flags);
+    REQUIRE(count == 3);
+
+    auto inverses = std::vector<tinyla::mat<4,TestType>>(matrices.size(), tinyla::mat<4,TestType>{tinyla::mat_init::zero});
+    tinyla::from_soa<TestType, pack::lanes>(packs, inverses);
+    for (std::size_t i = 0; i < matrices.size(); ++i) {
+        CAPTURE(i);
+        REQUIRE(determinants[i] == Catch::Approx(matrices[i].determinant()).margin(1e-4));
+        REQUIRE(flags[i] == (i % 7 == 3));
+        compare(inverses[i], matrices[i].inverted(), TestType{1e-4});
+    }
+    // Padding lanes hold the identity.
+    REQUIRE(!flags[matrices.size()]);
+    REQUIRE(determinants[matrices.size()] == TestType{1});
+}
+
+int main(int argc, const char* argv[])
+{
+    return Catch::Session().run(argc, argv);
+}
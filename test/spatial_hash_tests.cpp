@@ -0,0 +1,127 @@
+#include <tinyla/spatial_hash.hpp>
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch_all.hpp>
+#include "compare.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+static std::vector<tinyla::vec3f> make_points(std::size_t count, std::uint64_t seed)
+{
+    auto next = [&seed] {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        return static_cast<float>(seed >> 40) / static_cast<float>(1 << 24);
+    };
+    auto points = std::vector<tinyla::vec3f>{};
+    for (std::size_t i = 0; i < count; ++i) {
+        auto const x = next();
+        auto const y = next();
+        auto const z = next();
+        points.emplace_back(4.0f * x - 2.0f, 4.0f * y - 2.0f, 4.0f * z - 2.0f);
+    }
+    return points;
+}
+
+TEST_CASE("spatial_hash buckets", "[spatial_hash]")
+{
+    auto const points = make_points(10000, 1);
+    auto grid = tinyla::spatial_hash<float>{0.25f, 1000};
+    REQUIRE(grid.bucket_count() == 1024);
+    grid.rebuild(points);
+    REQUIRE(grid.size() == points.size());
+
+    auto seen = std::vector<bool>(points.size(), false);
+    std::size_t position = 0;
+    for (std::uint32_t b = 0; b < grid.bucket_count(); ++b) {
+        for (auto const i : grid.bucket(b)) {
+            REQUIRE(grid.order()[position++] == i);
+            REQUIRE(grid.bucket_of(grid.cell_of(points[i])) == b);
+            REQUIRE(!seen[i]);
+            seen[i] = true;
+        }
+    }
+    REQUIRE(position == points.size());
+    compare(grid.cell_of(tinyla::vec3f{-0.1f, 0.3f, 0.5f}), tinyla::vec3i{-1, 1, 2});
+}
+
+TEST_CASE("spatial_hash neighbours", "[spatial_hash]")
+{
+    auto const points = make_points(5000, 2);
+    auto xs = std::vector<float>{};
+    auto ys = std::vector<float>{};
+    auto zs = std::vector<float>{};
+    for (auto const& p : points) {
+        xs.push_back(p.x());
+        ys.push_back(p.y());
+        zs.push_back(p.z());
+    }
+
+    // Few buckets force collisions between neighbouring cells.
+    for (std::size_t buckets : {std::size_t{8}, std::size_t{4096}}) {
+        auto grid = tinyla::spatial_hash<float>{0.3f, buckets};
+        grid.rebuild(xs, ys, zs, tinyla::parallel::options{.threads = 4});
+
+        for (auto const& q : make_points(40, 3)) {
+            auto found = std::vector<std::uint32_t>{};
+            grid.for_each_neighbor(q, 0.3f, [&](std::uint32_t i, float d) {
+                REQUIRE(d == (points[i] - q).length_squared());
+                found.push_back(i);
+            });
+            std::sort(found.begin(), found.end());
+
+            auto expected = std::vector<std::uint32_t>{};
+            for (std::uint32_t i = 0; i < points.size(); ++i) {
+                if ((points[i] - q).length_squared() <= 0.3f * 0.3f) expected.push_back(i);
+            }
+            REQUIRE(found == expected);
+        }
+    }
+}
+
+TEST_CASE("spatial_hash clamps non-finite and far coordinates", "[spatial_hash]")
+{
+    constexpr auto nan = std::numeric_limits<float>::quiet_NaN();
+    constexpr auto inf = std::numeric_limits<float>::infinity();
+    constexpr auto limit = std::numeric_limits<int>::max() - 1;
+    auto grid = tinyla::spatial_hash<float>{0.25f, 64};
+    compare(grid.cell_of(tinyla::vec3f{nan, 0.3f, -nan}), tinyla::vec3i{0, 1, 0});
+    compare(grid.cell_of(tinyla::vec3f{inf, -inf, 1.0e30f}), tinyla::vec3i{limit, -limit, limit});
+    compare(grid.cell_of(tinyla::vec3f{-1.0e30f, 0.3f, 0.3f}), tinyla::vec3i{-limit, 1, 1});
+
+    auto const points = std::vector<tinyla::vec3f>{
+        tinyla::vec3f{nan, 0.0f, 0.0f},
+        tinyla::vec3f{inf, 0.0f, 0.0f},
+        tinyla::vec3f{1.0e30f, -1.0e30f, 0.0f},
+        tinyla::vec3f{0.1f, 0.1f, 0.1f}
+    };
+    grid.rebuild(points);
+    REQUIRE(grid.size() == points.size());
+    for (auto const& p : points) {
+        std::size_t found = 0;
+        grid.for_each_neighbor(p, 0.25f, [&found](std::uint32_t, float) { ++found; });
+        // A non-finite position is at a non-finite distance from everything, itself included.
+        REQUIRE(found == (std::isfinite(p.x()) ? 1u : 0u));
+    }
+}
+
+TEST_CASE("spatial_hash rebuild is deterministic", "[spatial_hash]")
+{
+    auto const points = make_points(50000, 4);
+    auto a = tinyla::spatial_hash<float>{0.1f, 1 << 16};
+    auto b = tinyla::spatial_hash<float>{0.1f, 1 << 16};
+    a.rebuild(points, tinyla::parallel::options{.threads = 1});
+    b.rebuild(points, tinyla::parallel::options{.threads = 7});
+    REQUIRE(std::equal(a.order().begin(), a.order().end(), b.order().begin(), b.order().end()));
+
+    auto empty = tinyla::spatial_hash<float>{0.1f, 16};
+    empty.rebuild(std::span<const tinyla::vec3f>{});
+    REQUIRE(empty.size() == 0);
+    REQUIRE(empty.bucket(3).empty());
+}
+
+int main(int argc, const char* argv[])
+{
+    return Catch::Session().run(argc, argv);
+}
@@ -0,0 +1,134 @@
+#include <tinyla/spatial_sort.hpp>
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch_all.hpp>
+#include "compare.hpp"
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+TEST_CASE("Morton keys", "[spatial_sort]")
+{
+    static_assert(tinyla::morton30(tinyla::vec3i{1, 0, 0}) == 1);
+    static_assert(tinyla::morton30(tinyla::vec3i{0, 1, 0}) == 2);
+    static_assert(tinyla::morton30(tinyla::vec3i{0, 0, 1}) == 4);
+    static_assert(tinyla::morton30(tinyla::vec3i{1023, 1023, 1023}) == (1u << 30) - 1);
+    static_assert(tinyla::morton63(tinyla::vec3i{0x1fffff, 0x1fffff, 0x1fffff}) == (std::uint64_t{1} << 63) - 1);
+
+    auto const cells = std::vector<tinyla::vec3i>{
+        tinyla::vec3i{0, 0, 0},
+        tinyla::vec3i{5, 700, 1023},
+        tinyla::vec3i{123, 456, 789}
+    };
+    for (auto const& c : cells) {
+        compare(tinyla::morton30_decode(tinyla::morton30(c)), c);
+        compare(tinyla::morton63_decode(tinyla::morton63(c)), c);
+    }
+    auto const big = tinyla::vec3i{2097151, 1048576, 777777};
+    compare(tinyla::morton63_decode(tinyla::morton63(big)), big);
+}
+
+TEST_CASE("Hilbert keys", "[spatial_sort]")
+{
+    static_assert(tinyla::hilbert63(tinyla::vec3i{0, 0, 0}) == 0);
+
+    // The first 8^k keys fill the cube of side 2^k at the origin, consecutive cells being face neighbours.
+    constexpr int side = 8;
+    auto by_key = std::vector<tinyla::vec3i>(side * side * side, tinyla::vec3i{-1, -1, -1});
+    for (int x = 0; x < side; ++x) {
+        for (int y = 0; y < side; ++y) {
+            for (int z = 0; z < side; ++z) {
+                auto const key = tinyla::hilbert63(tinyla::vec3i{x, y, z});
+                REQUIRE(key < by_key.size());
+                REQUIRE(by_key[key].x() == -1);
+                by_key[key] = tinyla::vec3i{x, y, z};
+            }
+        }
+    }
+    for (std::size_t i = 1; i < by_key.size(); ++i) {
+        auto const a = by_key[i - 1];
+        auto const b = by_key[i];
+        REQUIRE(std::abs(a.x() - b.x()) + std::abs(a.y() - b.y()) + std::abs(a.z() - b.z()) == 1);
+    }
+}
+
+TEST_CASE("vec3 quantize", "[spatial_sort]")
+{
+    auto const points = std::vector<tinyla::vec3f>{
+        tinyla::vec3f{0.0f, -1.0f, 2.0f},
+        tinyla::vec3f{1.0f, 1.0f, 2.0f},
+        tinyla::vec3f{0.5f, 0.0f, 2.0f},
+        tinyla::vec3f{2.0f, -3.0f, 2.0f}
+    };
+    auto const box = tinyla::aabb<3,float>{tinyla::vec3f{0.0f, -1.0f, 2.0f}, tinyla::vec3f{1.0f, 1.0f, 2.0f}};
+    auto cells = std::vector<tinyla::vec3i>(points.size(), tinyla::vec3i{tinyla::vec_init::zero});
+    tinyla::quantize(std::span<const tinyla::vec3f>{points}, box, 4, std::span<tinyla::vec3i>{cells});
+    compare(cells[0], tinyla::vec3i{0, 0, 0});
+    compare(cells[1], tinyla::vec3i{15, 15, 0});
+    compare(cells[2], tinyla::vec3i{8, 8, 0});
+    compare(cells[3], tinyla::vec3i{15, 0, 0});
+}
+
+TEST_CASE("vec3 quantize clamps non-finite and far coordinates", "[spatial_sort]")
+{
+    constexpr auto nan = std::numeric_limits<float>::quiet_NaN();
+    constexpr auto inf = std::numeric_limits<float>::infinity();
+    auto const points = std::vector<tinyla::vec3f>{
+        tinyla::vec3f{nan, 0.5f, -nan},
+        tinyla::vec3f{inf, -inf, 1.0e30f},
+        tinyla::vec3f{-1.0e30f, 0.5f, 0.5f}
+    };
+    auto const box = tinyla::aabb<3,float>{tinyla::vec3f{0.0f, 0.0f, 0.0f}, tinyla::vec3f{1.0f, 1.0f, 1.0f}};
+    auto cells = std::vector<tinyla::vec3i>(points.size(), tinyla::vec3i{tinyla::vec_init::zero});
+    tinyla::quantize(std::span<const tinyla::vec3f>{points}, box, 21, std::span<tinyla::vec3i>{cells});
+    compare(cells[0], tinyla::vec3i{0, 1 << 20, 0});
+    compare(cells[1], tinyla::vec3i{(1 << 21) - 1, 0, (1 << 21) - 1});
+    compare(cells[2], tinyla::vec3i{0, 1 << 20, 1 << 20});
+}
+
+TEST_CASE("Radix sort permutation", "[spatial_sort]")
+{
+    auto keys = std::vector<std::uint64_t>(100000);
+    std::uint64_t state = 12345;
+    for (auto& k : keys) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        k = (state >> 20) & 0xffffff;
+    }
+    auto const p = tinyla::sort_permutation(keys, 24);
+    REQUIRE(p.size() == keys.size());
+    for (std::size_t i = 1; i < p.size(); ++i) {
+        REQUIRE(keys[p[i - 1]] <= keys[p[i]]);
+        if (keys[p[i - 1]] == keys[p[i]]) REQUIRE(p[i - 1] < p[i]);
+    }
+    REQUIRE(p == tinyla::sort_permutation(keys, 24, tinyla::parallel::options{.threads = 1}));
+}
+
+TEST_CASE("vec3 spatial sort", "[spatial_sort]")
+{
+    // Points on a lattice shuffled by a stride; sorting along either curve keeps consecutive points close.
+    constexpr int side = 16;
+    constexpr std::size_t count = side * side * side;
+    auto points = std::vector<tinyla::vec3d>{};
+    for (std::size_t i = 0; i < count; ++i) {
+        auto const j = (i * 1237) % count;
+        points.emplace_back(double(j % side), double((j / side) % side), double(j / (side * side)));
+    }
+
+    for (auto const curve : {tinyla::curve::morton, tinyla::curve::hilbert}) {
+        auto const p = tinyla::spatial_sort(std::span<const tinyla::vec3d>{points}, curve);
+        REQUIRE(p.size() == count);
+        auto seen = std::vector<bool>(count, false);
+        double total = 0.0;
+        for (std::size_t i = 0; i < count; ++i) {
+            REQUIRE(!seen[p[i]]);
+            seen[p[i]] = true;
+            if (i > 0) total += (points[p[i]] - points[p[i - 1]]).length();
+        }
+        REQUIRE(total < 2.0 * count);
+        if (curve == tinyla::curve::hilbert) REQUIRE(total == Catch::Approx(double(count - 1)));
+    }
+}
+
+int main(int argc, const char* argv[])
+{
+    return Catch::Session().run(argc, argv);
+}
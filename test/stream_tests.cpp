@@ -0,0 +1,111 @@
+#include <tinyla/geom.hpp>
+#include <tinyla/io.hpp>
+#include <tinyla/stream.hpp>
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch_all.hpp>
+#include "compare.hpp"
+#include <filesystem>
+#include <stdexcept>
+#include <vector>
+
+using namespace tinyla::geom::literals;
+
+static std::filesystem::path temp_file(char const* name)
+{
+    return std::filesystem::temp_directory_path() / name;
+}
+
+static std::vector<tinyla::vec3d> make_points(std::size_t count)
+{
+    auto points = std::vector<tinyla::vec3d>{};
+    for (std::size_t i = 0; i < count; ++i) {
+        points.emplace_back(double(i % 101), double(i % 37) - 18.0, -double(i % 13) - 1.0);
+    }
+    return points;
+}
+
+TEST_CASE("stream pipeline transforms, filters and projects chunks", "[stream]")
+{
+    auto const input = temp_file("tinyla_stream_tests_input.bin");
+    auto const output = temp_file("tinyla_stream_tests_output.bin");
+    auto const points = make_points(10000);
+    REQUIRE(!tinyla::io::write<tinyla::vec3d>(input, points));
+
+    auto m = tinyla::geom::translation(tinyla::vec3d{1.0, 2.0, 3.0});
+    tinyla::geom::post_rotate(m, 30.0_degd, {0.0, 1.0, 0.0});
+    auto const p = tinyla::geom::perspective(tinyla::geom::frustum{60.0_degd, 1.0, 0.1, 100.0},
+        tinyla::geom::handedness::right, tinyla::geom::clip_volume::zero_to_one);
+    auto const keep = [](tinyla::vec3d const& v) { return v.y() > 0.0; };
+
+    auto expected = std::vector<tinyla::vec3d>{};
+    for (auto const& point : points) {
+        auto const v = m * tinyla::vec4d{point, 1.0};
+        auto const q = tinyla::vec3d{v.x(), v.y(), v.z()};
+        if (keep(q)) {
+            auto const r = tinyla::geom::project(p, tinyla::vec4d{q, 1.0});
+            expected.emplace_back(r.x(), r.y(), r.z());
+        }
+    }
+
+    for (std::size_t chunk_size : {std::size_t{777}, std::size_t{10000}, std::size_t{65536}}) {
+        CAPTURE(chunk_size);
+        auto pipeline = tinyla::stream::pipeline<double>{chunk_size};
+        pipeline.transform(m).filter(keep).project(p);
+        REQUIRE(!pipeline.run(input, output));
+
+        auto const mapped = tinyla::io::mapped_array<tinyla::vec3d>::open(output);
+        REQUIRE(mapped.has_value());
+        REQUIRE(mapped->size() == expected.size());
+        auto const result = mapped->elements();
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            CAPTURE(i);
+            compare(result[i], expected[i]);
+        }
+    }
+
+    std::filesystem::remove(input);
+    std::filesystem::remove(output);
+}
+
+TEST_CASE("stream pipeline reports missing and mismatching input", "[stream]")
+{
+    auto const input = temp_file("tinyla_stream_tests_mismatch.bin");
+    auto const output = temp_file("tinyla_stream_tests_mismatch_output.bin");
+    auto const pipeline = tinyla::stream::pipeline<double>{};
+
+    std::filesystem::remove(input);
+    REQUIRE(pipeline.run(input, output) == std::errc::no_such_file_or_directory);
+
+    auto const points = std::vector<tinyla::vec3f>{tinyla::vec3f{1.0f, 2.0f, 3.0f}};
+    REQUIRE(!tinyla::io::write<tinyla::vec3f>(input, points));
+    REQUIRE(pipeline.run(input, output) == std::errc::invalid_argument);
+
+    std::filesystem::remove(input);
+    std::filesystem::remove(output);
+}
+
+TEST_CASE("stream pipeline rethrows stage exceptions after stopping its threads", "[stream]")
+{
+    auto const input = temp_file("tinyla_stream_tests_throwing.bin");
+    auto const output = temp_file("tinyla_stream_tests_throwing_output.bin");
+    REQUIRE(!tinyla::io::write<tinyla::vec3d>(input, make_points(10000)));
+
+    for (std::size_t failing_chunk : {std::size_t{0}, std::size_t{2}, std::size_t{12}}) {
+        CAPTURE(failing_chunk);
+        auto chunks = std::size_t{0};
+        auto pipeline = tinyla::stream::pipeline<double>{777};
+        pipeline.then([&chunks, failing_chunk](std::span<tinyla::vec3d> chunk) {
+            if (chunks++ == failing_chunk) throw std::runtime_error{"stage failed"};
+            return chunk.size();
+        });
+        REQUIRE_THROWS_AS(pipeline.run(input, output), std::runtime_error);
+    }
+
+    std::filesystem::remove(input);
+    std::filesystem::remove(output);
+}
+
+int main(int argc, const char* argv[])
+{
+    return Catch::Session().run(argc, argv);
+}
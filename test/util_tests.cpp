@@ -0,0 +1,143 @@
+#include <tinyla/util.hpp>
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch_all.hpp>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <vector>
+
+constexpr auto sqrt_args = std::array{0.0, 1.0e-300, 0.25, 1.0, 2.0, 3.0, 1.0e6, 1.0e300};
+constexpr auto trig_args = std::array{-100.0, -7.5, -std::numbers::pi, -1.0, 0.0, 0.5,
+                                       std::numbers::pi / 4, std::numbers::pi / 2, 3.0, 1000.0};
+
+template<typename T, std::size_t M>
+constexpr std::array<T, M> constant_evaluated(std::array<double, M> const& args, T (*f)(T))
+{
+    auto result = std::array<T, M>{};
+    for (std::size_t i = 0; i < M; ++i) result[i] = f(static_cast<T>(args[i]));
+    return result;
+}
+
+TEST_CASE("sqrt is constant evaluated", "[util]")
+{
+    STATIC_REQUIRE(tinyla::sqrt(4.0) == 2.0);
+    STATIC_REQUIRE(tinyla::sqrt(2.25f) == 1.5f);
+
+    constexpr auto d = constant_evaluated<double>(sqrt_args, tinyla::sqrt<double>);
+    for (std::size_t i = 0; i < sqrt_args.size(); ++i) {
+        CAPTURE(i);
+        REQUIRE(d[i] == Catch::Approx(std::sqrt(sqrt_args[i])).epsilon(1e-15));
+    }
+    constexpr auto f = constant_evaluated<float>(std::array{2.0, 3.0, 1.0e-30, 1.0e30}, tinyla::sqrt<float>);
+    REQUIRE(f[0] == std::sqrt(2.0f));
+    REQUIRE(f[1] == std::sqrt(3.0f));
+    REQUIRE(f[2] == std::sqrt(1.0e-30f));
+    REQUIRE(f[3] == std::sqrt(1.0e30f));
+}
+
+TEST_CASE("sin, cos and tan are constant evaluated", "[util]")
+{
+    STATIC_REQUIRE(tinyla::sin(0.0) == 0.0);
+    STATIC_REQUIRE(tinyla::cos(0.0f) == 1.0f);
+
+    constexpr auto sin = constant_evaluated<double>(trig_args, tinyla::sin<double>);
+    constexpr auto cos = constant_evaluated<double>(trig_args, tinyla::cos<double>);
+    constexpr auto tan = constant_evaluated<double>(trig_args, tinyla::tan<double>);
+    constexpr auto sinf = constant_evaluated<float>(trig_args, tinyla::sin<float>);
+    constexpr auto cosf = constant_evaluated<float>(trig_args, tinyla::cos<float>);
+    for (std::size_t i = 0; i < trig_args.size(); ++i) {
+        CAPTURE(i);
+        REQUIRE(sin[i] == Catch::Approx(std::sin(trig_args[i])).margin(1e-13));
+        REQUIRE(cos[i] == Catch::Approx(std::cos(trig_args[i])).margin(1e-13));
+        REQUIRE(tan[i] == Catch::Approx(std::tan(trig_args[i])).epsilon(1e-12));
+        REQUIRE(sinf[i] == Catch::Approx(std::sin(static_cast<float>(trig_args[i]))).margin(1e-6));
+        REQUIRE(cosf[i] == Catch::Approx(std::cos(static_cast<float>(trig_args[i]))).margin(1e-6));
+    }
+}
+
+TEST_CASE("sin and cos of large double arguments are constant evaluated", "[util]")
+{
+    constexpr auto args = std::array{-271828.1828, 1.0e5, -1.0e6, 12345678.9, 1.0e8, 3.0e8};
+    constexpr auto sin = constant_evaluated<double>(args, tinyla::sin<double>);
+    constexpr auto cos = constant_evaluated<double>(args, tinyla::cos<double>);
+    for (std::size_t i = 0; i < args.size(); ++i) {
+        CAPTURE(i);
+        REQUIRE(std::abs(sin[i] - std::sin(args[i])) < 1e-15);
+        REQUIRE(std::abs(cos[i] - std::cos(args[i])) < 1e-15);
+    }
+}
+
+TEST_CASE("sin and cos of large long double arguments are constant evaluated", "[util]")
+{
+    constexpr auto args = std::array{-271828.1828, -1000.0, 12345.678, 1.0e6, 3.0e8};
+    constexpr auto sin = constant_evaluated<long double>(args, tinyla::sin<long double>);
+    constexpr auto cos = constant_evaluated<long double>(args, tinyla::cos<long double>);
+    for (std::size_t i = 0; i < args.size(); ++i) {
+        CAPTURE(i);
+        auto const x = static_cast<long double>(args[i]);
+        REQUIRE(std::abs(sin[i] - std::sin(x)) < 1e-17L);
+        REQUIRE(std::abs(cos[i] - std::cos(x)) < 1e-17L);
+    }
+}
+
+TEST_CASE("close and close_to_zero are constant evaluated", "[util]")
+{
+    STATIC_REQUIRE(tinyla::close(-1.0f, -1.0f));
+    STATIC_REQUIRE(!tinyla::close(-1.0f, 1.0f));
+    STATIC_REQUIRE(tinyla::close_to_zero(-0.0));
+    STATIC_REQUIRE(!tinyla::close_to_zero(-1.0e-3));
+}
+
+TEST_CASE("sincos", "[util]")
+{
+    constexpr auto sc = tinyla::sincos(std::numbers::pi / 6);
+    static_assert(tinyla::abs(sc.sin - 0.5) < 1e-15);
+    REQUIRE(sc.cos == Catch::Approx(std::sqrt(3.0) / 2));
+
+    auto x = std::vector<double>{};
+    for (int i = -20000; i <= 20000; ++i) x.push_back(i * 0.0123);
+    x.insert(x.end(), trig_args.begin(), trig_args.end());
+
+    auto s = std::vector<double>(x.size());
+    auto c = std::vector<double>(x.size());
+    tinyla::sincos<double>(x, s, c);
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        CAPTURE(x[i]);
+        REQUIRE(std::abs(s[i] - std::sin(x[i])) <= 4e-16);
+        REQUIRE(std::abs(c[i] - std::cos(x[i])) <= 4e-16);
+    }
+
+    auto xf = std::vector<float>(x.begin(), x.end());
+    auto sf = std::vector<float>(x.size());
+    auto cf = std::vector<float>(x.size());
+    tinyla::sincos<float>(xf, sf, cf);
+    for (std::size_t i = 0; i < xf.size(); ++i) {
+        CAPTURE(xf[i]);
+        REQUIRE(std::abs(sf[i] - std::sin(xf[i])) <= 2.5e-7f);
+        REQUIRE(std::abs(cf[i] - std::cos(xf[i])) <= 2.5e-7f);
+    }
+}
+
+TEST_CASE("sincos of large and non-finite float arguments", "[util]")
+{
+    auto x = std::vector<float>{};
+    for (int i = -50000; i <= 50000; ++i) x.push_back(static_cast<float>(i) * 2.0f + 0.3f * static_cast<float>(i % 7));
+    x.insert(x.end(), {1.0e30f, -3.0e9f, std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::infinity()});
+
+    auto s = std::vector<float>(x.size());
+    auto c = std::vector<float>(x.size());
+    tinyla::sincos<float>(x, s, c);
+    for (std::size_t i = 0; i + 4 < x.size(); ++i) {
+        CAPTURE(x[i]);
+        REQUIRE(std::abs(s[i] - std::sin(static_cast<double>(x[i]))) <= 2.5e-7);
+        REQUIRE(std::abs(c[i] - std::cos(static_cast<double>(x[i]))) <= 2.5e-7);
+    }
+    REQUIRE(std::isnan(s[x.size() - 2]));
+    REQUIRE(std::isnan(c[x.size() - 1]));
+}
+
+int main(int argc, const char* argv[])
+{
+    return Catch::Session().run(argc, argv);
+}
@@ -2,6 +2,7 @@
 #define CATCH_CONFIG_RUNNER
 #include <catch2/catch_all.hpp>
 #include "compare.hpp"
+#include <type_traits>
 #include <vector>
 
 constexpr auto v4a = tinyla::vec4f{1.0f, 2.0f, 3.0f, 4.0f};
@@ -41,6 +42,12 @@ TEST_CASE("vec2 length", "[vec2]")
     REQUIRE(tinyla::vec2f{ 2.0f, -2.0f}.length() == std::sqrt(8.0f));    // two
 }
 
+TEST_CASE("vec2 length is constant evaluated", "[vec2]")
+{
+    STATIC_REQUIRE(tinyla::vec2f{ 3.0f, -4.0f}.length() == 5.0f);
+    STATIC_REQUIRE(tinyla::vec2f{ 3.0f, -4.0f}.normalized().x() == 0.6f);
+}
+
 TEST_CASE("vec2 normalized", "[vec2]")
 {
     // For zero vector glm::normalize() returns vector of NaNs.
@@ -99,6 +106,14 @@ TEST_CASE("vec3 length", "[vec3]")
     REQUIRE(tinyla::vec3f{ 2.0f, -2.0f,  2.0f}.length() == std::sqrt(12.0f));    // two
 }
 
+TEST_CASE("vec3i length", "[vec3]")
+{
+    REQUIRE(tinyla::vec3i{ 3,  4,  0}.length() == 5);
+    REQUIRE(tinyla::vec3i{ 0, -3, -4}.length() == 5);
+    REQUIRE(tinyla::vec3i{ 1,  1,  1}.length() == 1);    // truncated sqrt(3)
+    STATIC_REQUIRE(tinyla::vec3i{2, 3, 6}.length() == 7);
+}
+
 TEST_CASE("vec4 is constructed from initializer list", "[vec4]")
 {
     constexpr auto m = tinyla::vec4f{0.0f, 0.1f, 0.2f, 0.3f};
@@ -179,6 +194,18 @@ TEST_CASE("vec4 operator/", "[vec4]")
     compare(v, v4a_divided_by_v4b);
 }
 
+TEST_CASE("vec4 scalar operators take the scalar type", "[vec4]")
+{
+    // A double scalar is no longer narrowed to float, nor an int vector widened to float and back.
+    constexpr auto d = tinyla::vec4d{1.0, 2.0, 3.0, 4.0} * 0.1;
+    STATIC_REQUIRE(d[0] == 0.1);
+    STATIC_REQUIRE(d[2] == 3.0 * 0.1);
+    constexpr auto q = tinyla::vec4d{1.0, 2.0, 3.0, 4.0} / 3.0;
+    STATIC_REQUIRE(q[0] == 1.0 / 3.0);
+    constexpr auto i = 3 * tinyla::vec4i{1, 2, 3, 4} / 2;
+    compare(i, tinyla::vec4i{1, 3, 4, 6});
+}
+
 TEST_CASE("vec4 unary operator-", "[vec4]")
 {
     constexpr auto v = -tinyla::vec4f{0.0f, -0.1f, 0.2f, -0.3f};
@@ -220,6 +247,57 @@ TEST_CASE("vec4 from vec3")
     REQUIRE(v4[3] == 3);
 }
 
+TEST_CASE("vec4 from vec2 is checked at compile time")
+{
+    constexpr auto v4 = tinyla::vec4f{tinyla::vec2f{1.0f, 2.0f}, 3.0f, 4.0f};
+    STATIC_REQUIRE(v4[0] == 1.0f);
+    STATIC_REQUIRE(v4[3] == 4.0f);
+    STATIC_REQUIRE(!std::is_constructible_v<tinyla::vec4f, tinyla::vec2f, float>);
+}
+
+TEST_CASE("vec4 swizzles")
+{
+    constexpr auto v = tinyla::vec4f{1.0f, 2.0f, 3.0f, 4.0f};
+    STATIC_REQUIRE(std::is_same_v<decltype(v.xyz()), tinyla::vec3f>);
+    compare(v.xyz(), tinyla::vec3f{1.0f, 2.0f, 3.0f});
+    compare(v.zyx(), tinyla::vec3f{3.0f, 2.0f, 1.0f});
+    compare(v.xy(), tinyla::vec2f{1.0f, 2.0f});
+    compare(v.yx(), tinyla::vec2f{2.0f, 1.0f});
+    compare(v.xz(), tinyla::vec2f{1.0f, 3.0f});
+    compare(v.yz(), tinyla::vec2f{2.0f, 3.0f});
+    compare(v.swizzle<3, 3, 0, 1, 2>(), tinyla::vec{4.0f, 4.0f, 1.0f, 2.0f, 3.0f});
+    STATIC_REQUIRE(v.swizzle<3, 0>()[0] == 4.0f);
+}
+
+TEST_CASE("vec4 views write in place")
+{
+    auto v = tinyla::vec4f{1.0f, 2.0f, 3.0f, 4.0f};
+    v.view<0, 1, 2>() = tinyla::vec3f{5.0f, 6.0f, 7.0f};
+    compare(v, tinyla::vec4f{5.0f, 6.0f, 7.0f, 4.0f});
+
+    v.view<3, 0>() += tinyla::vec2f{1.0f, 1.0f};
+    compare(v, tinyla::vec4f{6.0f, 6.0f, 7.0f, 5.0f});
+
+    v.view<1, 2>() *= 2.0f;
+    v.view<0, 1>() -= tinyla::vec2f{1.0f, 2.0f};
+    compare(v, tinyla::vec4f{5.0f, 10.0f, 14.0f, 5.0f});
+
+    // Swapping through views reads all components before writing.
+    v.view<0, 1>() = v.view<1, 0>();
+    compare(v, tinyla::vec4f{10.0f, 5.0f, 14.0f, 5.0f});
+
+    auto const view = v.view<2, 0>();
+    view[1] = 0.0f;
+    REQUIRE(v[0] == 0.0f);
+    tinyla::vec2f const copy = view;
+    compare(copy, tinyla::vec2f{14.0f, 0.0f});
+
+    auto const& cv = v;
+    STATIC_REQUIRE(std::is_same_v<decltype(cv.view<0, 1>()[0]), float>);
+    STATIC_REQUIRE(!std::is_assignable_v<decltype(cv.view<0, 1>()), tinyla::vec2f>);
+    compare(cv.view<3, 2>().get(), tinyla::vec2f{5.0f, 14.0f});
+}
+
 int main(int argc, const char* argv[])
 {
     return Catch::Session().run(argc, argv);